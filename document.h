@@ -0,0 +1,79 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+using namespace std;
+
+// ═══════════════════════════════════════════════════════════════════
+//  ANALYZED DOCUMENT
+//  একটা input একবারই scan হয় — topic model আর sentiment analyzer
+//  দুজনেই এই একই representation থেকে পড়ে, আলাদা করে tokenize করে না।
+// ═══════════════════════════════════════════════════════════════════
+
+// tokenize() এর output arena — সব token একটা string এ পরপর লেখা,
+// ends[i] হল token i এর শেষ offset। একই buffer বারবার দিলে
+// warm-up এর পরে আর কোনো allocation হয় না।
+struct TokenBuffer
+{
+    string           chars;
+    vector<uint32_t> ends;
+
+    void   clear()       { chars.clear(); ends.clear(); }
+    size_t size()  const { return ends.size(); }
+    bool   empty() const { return ends.empty(); }
+    string_view operator[](size_t i) const
+    {
+        size_t b = i ? ends[i - 1] : 0;
+        return string_view(chars.data() + b, ends[i] - b);
+    }
+};
+
+// words এর প্রতিটা token এর flag
+enum : uint8_t {
+    DOC_WORD_CAPS = 1,   // সব letter uppercase, আর raw token ১ char এর বেশি ("HAPPY", "OK!")
+};
+
+struct AnalyzedDocument
+{
+    TokenBuffer     words;       // whitespace token, শুধু letter, lowercase; letter না থাকলে empty token
+    vector<uint8_t> wordFlags;   // words এর সাথে index মিলিয়ে
+    TokenBuffer     stems;       // stopword/ছোট word বাদ, Porter stem — topic model এর input
+    int             qmarks   = 0;
+    int             excmarks = 0;
+
+    void clear()
+    {
+        words.clear(); wordFlags.clear(); stems.clear();
+        qmarks = excmarks = 0;
+    }
+};
+
+// text কে whitespace এ ভেঙে words, wordFlags আর '?'/'!' count ভরে।
+// Letter ছাড়া token ও position হিসেবে থাকে — sentiment এর window
+// গুলো token গুনে চলে। stems এ হাত দেয় না (TextPreprocessor::analyze)।
+inline void scanWords(string_view text, AnalyzedDocument& doc)
+{
+    doc.words.clear(); doc.wordFlags.clear();
+    doc.qmarks = doc.excmarks = 0;
+    TokenBuffer& out = doc.words;
+    size_t i = 0, n = text.size();
+    while (i < n) {
+        while (i < n && isspace((unsigned char)text[i])) i++;
+        if (i == n) break;
+
+        size_t raw = 0;
+        bool   allCaps = true;
+        for (; i < n && !isspace((unsigned char)text[i]); i++, raw++) {
+            unsigned char c = text[i];
+            if (c == '?') doc.qmarks++;
+            if (c == '!') doc.excmarks++;
+            if (!isalpha(c)) continue;
+            if (!isupper(c)) allCaps = false;
+            out.chars += (char)tolower(c);
+        }
+        out.ends.push_back((uint32_t)out.chars.size());
+        doc.wordFlags.push_back(allCaps && raw > 1 ? DOC_WORD_CAPS : 0);
+    }
+}
@@ -66,7 +66,10 @@ struct Result {
     double score;
 };
 
-int main()
+const string MODEL_FILE      = "topic_model.bin";
+const string CHECKPOINT_FILE = "topic_model.ckpt";
+
+int main(int argc, char* argv[])
 {
     cout << "\n" << string(75, '=') << endl;
     cout << "          SIMPLE NLP ANALYSIS SYSTEM" << endl;
@@ -76,8 +79,24 @@ int main()
     SupervisedLDA     topicModel;
     SentimentAnalyzer sentAnalyzer;
 
-    topicModel.loadData("input.txt");
-    topicModel.train();
+    // saved model থাকলে সেটাই load করি; "--retrain" দিলে আবার train হয়,
+    // "--stream" দিলে corpus memory তে না তুলে streaming SVI দিয়ে
+    bool retrain = argc > 1 && string(argv[1]) == "--retrain";
+    bool stream  = argc > 1 && string(argv[1]) == "--stream";
+    if (stream) {
+        topicModel.setThreads(0);
+        if (!topicModel.trainStreaming("input.txt")) return 1;
+        topicModel.save(MODEL_FILE);
+    } else if (retrain || !topicModel.load(MODEL_FILE)) {
+        if (!topicModel.loadData("input.txt")) return 1;
+        topicModel.sortVocabByFrequency();   // hot nw row গুলো পাশাপাশি
+        topicModel.setThreads(0);   // সব core দিয়ে Gibbs sampling
+        // আগের training মাঝপথে থেমে থাকলে শেষ checkpoint থেকে চলে
+        topicModel.setCheckpoint(CHECKPOINT_FILE, 50);
+        topicModel.resume(CHECKPOINT_FILE);
+        if (!topicModel.train()) return 1;
+        topicModel.save(MODEL_FILE);
+    }
 
     // ── Read test.txt ──────────────────────────────────────────────
     vector<string> inputs;
@@ -126,9 +145,16 @@ int main()
     };
     vector<Result> results;
 
-    for (const string& sentence : inputs) {
-        string topic = topicModel.predict(sentence);
-        SentimentResult sr = sentAnalyzer.analyze(sentence);
+    // প্রতিটা sentence একবারই tokenize হয় — topic আর sentiment দুজনেই
+    // একই AnalyzedDocument পড়ে। Topic গুলো একবারে সব core এ।
+    TextPreprocessor         preprocessor;
+    vector<AnalyzedDocument> docs   = preprocessor.analyzeBatch(inputs);
+    vector<TopicPrediction>  topics = topicModel.predictBatch(docs);
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const string& sentence = inputs[i];
+        string topic = topicModel.topicLabel(topics[i].topic);
+        SentimentResult sr = sentAnalyzer.analyze(docs[i]);
 
         string sentiment = sr.intensity.empty()
                            ? sr.label
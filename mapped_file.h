@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+using namespace std;
+
+// ═══════════════════════════════════════════════════════════════════
+//  MEMORY-MAPPED FILE
+//  View of a whole file. Several processes mapping the same file share
+//  one page-cached copy, so nothing is read until touched. A writable
+//  mapping writes straight back to the file (out-of-core token shards).
+// ═══════════════════════════════════════════════════════════════════
+class MappedFile
+{
+    char*       ptr = nullptr;
+    size_t      len = 0;
+#ifdef _WIN32
+    HANDLE file    = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const string& path, bool writable = false)
+    {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                           FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz)) { close(); return false; }
+        len = (size_t)sz.QuadPart;
+        if (len == 0) return true;
+        mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                     0, 0, nullptr);
+        if (!mapping) { close(); return false; }
+        ptr = (char*)MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        if (!ptr) { close(); return false; }
+#else
+        int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        len = (size_t)st.st_size;
+        if (len > 0) {
+            int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* p = mmap(nullptr, len, prot, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) { ::close(fd); len = 0; return false; }
+            ptr = (char*)p;
+        }
+        ::close(fd);   // mapping টা fd ছাড়াও valid থাকে
+#endif
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (ptr)     UnmapViewOfFile(ptr);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr; file = INVALID_HANDLE_VALUE;
+#else
+        if (ptr) munmap(ptr, len);
+#endif
+        ptr = nullptr; len = 0;
+    }
+
+    // Pages are read from disk now rather than on first access. Call it
+    // from a background thread to overlap the I/O with other work.
+    void prefetch() const
+    {
+        if (!ptr) return;
+#ifndef _WIN32
+        madvise(ptr, len, MADV_WILLNEED);
+#endif
+        // touch one byte per page — the hint alone may be ignored
+        volatile char sink = 0;
+        for (size_t i = 0; i < len; i += 4096) sink = sink + ptr[i];
+    }
+
+    const char* data() const { return ptr; }
+    char*       data()       { return ptr; }   // write only through a writable mapping
+    size_t      size() const { return len; }
+};
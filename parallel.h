@@ -0,0 +1,44 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+// ═══════════════════════════════════════════════════════════════════
+//  THREADING HELPERS
+// ═══════════════════════════════════════════════════════════════════
+
+// 0 বা negative মানে "যত core আছে"
+inline int resolveThreads(int n)
+{
+    if (n <= 0) n = (int)thread::hardware_concurrency();
+    return max(1, n);
+}
+
+// fn(tid) কে T টা thread এ চালায় — tid 0 calling thread এই চলে
+template <class F>
+void runThreads(int T, F fn)
+{
+    if (T <= 1) { fn(0); return; }
+    vector<thread> pool;
+    pool.reserve(T - 1);
+    for (int t = 1; t < T; t++) pool.emplace_back(fn, t);
+    fn(0);
+    for (auto& th : pool) th.join();
+}
+
+// [0, n) এর প্রতিটা i তে fn(i) — T টা thread grain সাইজের block এ কাজ
+// ভাগ করে নেয়, তাই ছোট-বড় item মিশে থাকলেও সব thread ব্যস্ত থাকে
+template <class F>
+void parallelFor(size_t n, int T, F fn, size_t grain = 64)
+{
+    T = (int)min<size_t>(max(1, T), (n + grain - 1) / grain);
+    if (T <= 1) { for (size_t i = 0; i < n; i++) fn(i); return; }
+    atomic<size_t> next(0);
+    runThreads(T, [&](int) {
+        size_t b;
+        while ((b = next.fetch_add(grain)) < n)
+            for (size_t i = b, e = min(n, b + grain); i < e; i++) fn(i);
+    });
+}
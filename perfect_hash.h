@@ -0,0 +1,151 @@
+#pragma once
+#include <array>
+#include <string_view>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+// ═══════════════════════════════════════════════════════════════════
+//  COMPILE-TIME PERFECT HASH TABLES
+//  Fixed word list (stopwords, lexicon) এর জন্য — table টা compile
+//  time এ বানানো হয় (hash-and-displace), runtime এ কোনো construction
+//  নেই। Lookup: একটা FNV hash, একটা slot mix, একটা string compare।
+// ═══════════════════════════════════════════════════════════════════
+
+constexpr uint32_t phHash(string_view s)
+{
+    uint32_t h = 2166136261u;
+    for (char c : s) { h ^= (unsigned char)c; h *= 16777619u; }
+    return h;
+}
+
+// bucket এর seed দিয়ে hash কে slot এ ছড়ায় (murmur3 finalizer)
+constexpr uint32_t phMix(uint32_t h, uint32_t seed)
+{
+    h ^= seed * 0x9E3779B9u;
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+constexpr size_t phPow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+template <size_t N>
+class PerfectHashIndex
+{
+public:
+    static constexpr size_t SLOTS   = phPow2(2 * N);     // load factor ≤ 0.5
+    static constexpr size_t BUCKETS = phPow2(N / 4 + 1); // bucket প্রতি গড়ে ~4 key
+
+    // key এর index, না থাকলে -1
+    constexpr int indexOf(string_view key) const
+    {
+        uint32_t h = phHash(key);
+        uint32_t e = slot[phMix(h, seed[h & (BUCKETS - 1)]) & (SLOTS - 1)];
+        return (e != 0 && keys[e - 1] == key) ? (int)e - 1 : -1;
+    }
+    constexpr size_t size() const { return N; }
+
+protected:
+    array<string_view, N>     keys{};
+    array<uint32_t, BUCKETS>  seed{};
+    array<uint32_t, SLOTS>    slot{};   // key index + 1; 0 = খালি
+
+    // keys ভরার পরে call হয়। বড় bucket আগে বসে; প্রতিটা bucket এর জন্য
+    // প্রথম seed যেটায় তার সব key খালি, আলাদা slot পায়।
+    constexpr void build()
+    {
+        array<uint32_t, N> h{}, member{};           // member: bucket অনুযায়ী সাজানো key index
+        array<uint32_t, BUCKETS + 1> start{};
+        array<uint32_t, BUCKETS> order{};
+        for (size_t i = 0; i < N; i++) {
+            h[i] = phHash(keys[i]);
+            start[(h[i] & (BUCKETS - 1)) + 1]++;
+        }
+        for (size_t b = 0; b < BUCKETS; b++) start[b + 1] += start[b];
+        array<uint32_t, BUCKETS> fill{};
+        for (size_t i = 0; i < N; i++) {
+            uint32_t b = h[i] & (BUCKETS - 1);
+            member[start[b] + fill[b]++] = i;
+        }
+        auto count = [&](uint32_t b) { return start[b + 1] - start[b]; };
+        for (size_t b = 0; b < BUCKETS; b++) order[b] = b;
+        for (size_t a = 1; a < BUCKETS; a++)
+            for (size_t b = a; b > 0 && count(order[b]) > count(order[b - 1]); b--) {
+                uint32_t t = order[b]; order[b] = order[b - 1]; order[b - 1] = t;
+            }
+
+        for (size_t ob = 0; ob < BUCKETS && count(order[ob]) > 0; ob++) {
+            const uint32_t b = order[ob];
+            for (uint32_t d = 0;; d++) {
+                // একই key দুবার থাকলে কোনো seed এই কাজ করবে না
+                if (d > (1u << 16)) throw "perfect hash: duplicate key";
+                uint32_t placed = start[b];
+                for (; placed < start[b + 1]; placed++) {
+                    uint32_t i = member[placed];
+                    uint32_t s = phMix(h[i], d) & (SLOTS - 1);
+                    if (slot[s] != 0) break;
+                    slot[s] = i + 1;
+                }
+                if (placed == start[b + 1]) { seed[b] = d; break; }
+                for (uint32_t p = start[b]; p < placed; p++)   // এই চেষ্টায় বসানো গুলো তুলে নিই
+                    slot[phMix(h[member[p]], d) & (SLOTS - 1)] = 0;
+            }
+        }
+    }
+};
+
+template <size_t N>
+class PerfectHashSet : public PerfectHashIndex<N>
+{
+public:
+    constexpr PerfectHashSet(const string_view (&words)[N])
+    {
+        for (size_t i = 0; i < N; i++) this->keys[i] = words[i];
+        this->build();
+    }
+    constexpr bool contains(string_view key) const { return this->indexOf(key) >= 0; }
+};
+
+template <class V, size_t N>
+class PerfectHashMap : public PerfectHashIndex<N>
+{
+    array<V, N> values{};
+
+public:
+    constexpr PerfectHashMap(const pair<string_view, V> (&entries)[N])
+    {
+        for (size_t i = 0; i < N; i++) {
+            this->keys[i] = entries[i].first;
+            values[i]     = entries[i].second;
+        }
+        this->build();
+    }
+    // না থাকলে nullptr
+    constexpr const V* find(string_view key) const
+    {
+        int i = this->indexOf(key);
+        return i < 0 ? nullptr : &values[i];
+    }
+    constexpr bool contains(string_view key) const { return this->indexOf(key) >= 0; }
+};
+
+// Braced list থেকে N deduce হয়: makePerfectSet({"a", "b"})
+template <size_t N>
+constexpr PerfectHashSet<N> makePerfectSet(const string_view (&words)[N])
+{
+    return PerfectHashSet<N>(words);
+}
+
+template <class V, size_t N>
+constexpr PerfectHashMap<V, N> makePerfectMap(const pair<string_view, V> (&entries)[N])
+{
+    return PerfectHashMap<V, N>(entries);
+}
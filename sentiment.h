@@ -1,8 +1,4 @@
-<<<<<<< HEAD
-#pragma once
-=======
 /*#pragma once
->>>>>>> 51c03b0
 #include <iostream>
 #include <vector>
 #include <string>
@@ -14,13 +10,6 @@
 #include <iomanip>
 using namespace std;
 
-<<<<<<< HEAD
-// ═══════════════════════════════════════════════════════════════════
-//  SENTIMENT ANALYSIS
-//  VADER-inspired lexicon + rules + emotion detection
-// ═══════════════════════════════════════════════════════════════════
-=======
->>>>>>> 51c03b0
 
 struct SentimentResult
 {
@@ -37,25 +26,16 @@ class SentimentAnalyzer
 {
 private:
     map<string, double> lexicon;
-<<<<<<< HEAD
-    set<string>         negWords;
-    map<string, double> intensifiers;
-=======
 
     set<string>         negWords;
 
     map<string, double> intensifiers;
 
->>>>>>> 51c03b0
     map<string, string> emotionMap;
 
     void buildLexicon()
     {
-<<<<<<< HEAD
-        // Positive words
-=======
 
->>>>>>> 51c03b0
         lexicon["excellent"]=3.5; lexicon["outstanding"]=3.5; lexicon["amazing"]=3.4;
         lexicon["fantastic"]=3.4; lexicon["wonderful"]=3.3;   lexicon["brilliant"]=3.3;
         lexicon["superb"]=3.2;    lexicon["perfect"]=3.1;     lexicon["incredible"]=3.1;
@@ -80,11 +60,7 @@ private:
         lexicon["marvelous"]=2.9; lexicon["spectacular"]=2.9; lexicon["phenomenal"]=3.0;
         lexicon["magnificent"]=3.0;lexicon["splendid"]=2.8;
 
-<<<<<<< HEAD
-        // Negative words
-=======
 
->>>>>>> 51c03b0
         lexicon["terrible"]=-3.5; lexicon["horrible"]=-3.5;   lexicon["awful"]=-3.4;
         lexicon["disgusting"]=-3.3;lexicon["abysmal"]=-3.2;   lexicon["appalling"]=-3.2;
         lexicon["bad"]=-2.0;      lexicon["poor"]=-2.0;       lexicon["hate"]=-2.5;
@@ -155,38 +131,26 @@ private:
         emotionMap["nasty"]="Disgust";  emotionMap["ugly"]="Disgust";
     }
 
-<<<<<<< HEAD
-=======
 
->>>>>>> 51c03b0
     string norm(const string& w)
     {
         string r = "";
         for (char c : w) if (isalpha(c)) r += tolower(c);
         return r;
     }
-<<<<<<< HEAD
-=======
     
->>>>>>> 51c03b0
 
     string detectEmotion(const vector<string>& tokens)
     {
         map<string, int> emotionCount;
-<<<<<<< HEAD
-=======
 
->>>>>>> 51c03b0
         for (const string& t : tokens) {
             string w = norm(t);
             if (emotionMap.count(w))
                 emotionCount[emotionMap[w]]++;
         }
         if (emotionCount.empty()) return "Neutral";
-<<<<<<< HEAD
-=======
 
->>>>>>> 51c03b0
         return max_element(emotionCount.begin(), emotionCount.end(),
             [](const pair<string,int>& a, const pair<string,int>& b){
                 return a.second < b.second;
@@ -220,28 +184,18 @@ public:
             cnt++;
 
             bool allCaps = true;
-<<<<<<< HEAD
-            for (char c : tokens[i]) if (isalpha(c) && !isupper(c)) { allCaps=false; break; }
-=======
 
             for (char c : tokens[i]) if (isalpha(c) && !isupper(c)) { allCaps=false; break; }
 
->>>>>>> 51c03b0
             if (allCaps && tokens[i].length() > 1)
                 ws *= (ws > 0) ? 1.2 : 0.8;
 
             if (i > 0 && intensifiers.count(norm(tokens[i-1])))
-<<<<<<< HEAD
-                ws *= intensifiers[norm(tokens[i-1])];
-
-            for (int j = max(0,i-3); j < i; j++)
-=======
 
                 ws *= intensifiers[norm(tokens[i-1])];
 
             for (int j = max(0,i-3); j < i; j++)
 
->>>>>>> 51c03b0
                 if (negWords.count(norm(tokens[j]))) { ws *= -0.74; break; }
 
             int exc = 0;
@@ -254,10 +208,7 @@ public:
         }
 
         double score = (cnt==0) ? 0.0 : raw / sqrt(raw*raw + 15.0);
-<<<<<<< HEAD
-=======
 
->>>>>>> 51c03b0
         score = max(-1.0, min(1.0, score));
 
         double total = posSum + negSum + 1e-9;
@@ -267,10 +218,7 @@ public:
         posR/=pct; negR/=pct; neuR/=pct;
 
         string label, intensity;
-<<<<<<< HEAD
-=======
 
->>>>>>> 51c03b0
         double a = fabs(score);
         if      (score >=  0.05) label = "POSITIVE";
         else if (score <= -0.05) label = "NEGATIVE";
@@ -282,10 +230,6 @@ public:
         else                 intensity = "";
 
         string emotion = detectEmotion(tokens);
-<<<<<<< HEAD
-        return {score, posR*100, negR*100, neuR*100, label, intensity, emotion};
-    }
-=======
 
         return {score, posR*100, negR*100, neuR*100, label, intensity, emotion};
     }
@@ -302,9 +246,310 @@ public:
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <string_view>
+#include "perfect_hash.h"
+#include "parallel.h"
+#include "document.h"
 using namespace std;
 
 
+// ═══════════════════════════════════════════════════════════════════
+//  WORD TABLES — compile time perfect hash, startup এ কিছু বানাতে হয় না
+// ═══════════════════════════════════════════════════════════════════
+
+// ── Sentiment lexicon: word → score ─────────────────────────────
+inline constexpr auto SENT_LEXICON = makePerfectMap<double>({
+    // ── Strong Positive (3.0 ~ 3.5) ───────────────────────────
+    {"excellent", 3.5},     {"outstanding", 3.5},
+    {"exceptional", 3.5},   {"extraordinary", 3.4},
+    {"amazing", 3.4},       {"fantastic", 3.4},
+    {"wonderful", 3.3},     {"brilliant", 3.3},
+    {"superb", 3.2},        {"perfect", 3.1},
+    {"incredible", 3.1},    {"phenomenal", 3.0},
+    {"magnificent", 3.0},   {"marvelous", 2.9},
+    {"spectacular", 2.9},   {"splendid", 2.8},
+    {"glorious", 2.8},      {"sublime", 2.8},
+    {"flawless", 3.0},      {"masterpiece", 3.2},
+    {"legendary", 3.0},     {"breathtaking", 3.1},
+    {"astounding", 3.0},    {"remarkable", 2.8},
+
+    // ── Moderate Positive (2.0 ~ 2.9) ─────────────────────────
+    {"awesome", 2.8},       {"great", 2.5},
+    {"love", 2.5},          {"loved", 2.5},
+    {"loving", 2.4},        {"best", 2.6},
+    {"happy", 2.1},         {"happiness", 2.2},
+    {"joy", 2.3},           {"joyful", 2.3},
+    {"joyous", 2.3},        {"excited", 2.2},
+    {"exciting", 2.2},      {"delight", 2.2},
+    {"delightful", 2.2},    {"cheerful", 2.0},
+    {"enjoy", 2.0},         {"enjoyed", 2.0},
+    {"enjoyable", 2.0},     {"fun", 2.0},
+    {"funny", 2.0},         {"impressive", 2.3},
+    {"pleased", 2.0},       {"glad", 1.9},
+    {"recommend", 1.9},     {"winning", 2.0},
+    {"win", 2.0},           {"won", 2.0},
+    {"charming", 2.0},      {"elegant", 2.1},
+    {"graceful", 2.0},      {"vibrant", 2.0},
+    {"thrilling", 2.3},     {"inspiring", 2.2},
+    {"motivated", 2.0},     {"energetic", 2.0},
+    {"enthusiastic", 2.1},  {"passionate", 2.1},
+    {"proud", 2.0},         {"grateful", 2.1},
+    {"thankful", 2.0},      {"blessed", 2.2},
+    {"fortunate", 2.0},     {"lucky", 1.9},
+    {"celebrate", 2.1},     {"celebration", 2.1},
+    {"triumph", 2.3},       {"victorious", 2.4},
+    {"achievement", 2.2},   {"accomplished", 2.1},
+    {"succeed", 2.1},       {"success", 2.1},
+    {"successful", 2.1},    {"innovative", 2.0},
+    {"creative", 1.8},
+
+    // ── Mild Positive (0.5 ~ 1.9) ─────────────────────────────
+    {"good", 2.0},          {"nice", 1.8},
+    {"like", 1.5},          {"liked", 1.5},
+    {"better", 1.8},        {"helpful", 1.8},
+    {"useful", 1.7},        {"smart", 1.8},
+    {"efficient", 1.8},     {"reliable", 1.8},
+    {"honest", 1.6},        {"hope", 1.7},
+    {"hopeful", 1.8},       {"strong", 1.5},
+    {"healthy", 1.7},       {"comfortable", 1.8},
+    {"friendly", 1.9},      {"clean", 1.5},
+    {"smooth", 1.7},        {"worthy", 1.6},
+    {"safe", 1.5},          {"positive", 1.9},
+    {"beautiful", 2.1},     {"ok", 0.9},
+    {"okay", 0.9},          {"alright", 0.8},
+    {"fair", 0.5},          {"decent", 1.2},
+    {"reasonable", 1.1},    {"adequate", 0.8},
+    {"satisfactory", 1.0},  {"acceptable", 0.9},
+    {"pleasant", 1.7},      {"pleasing", 1.7},
+    {"polite", 1.6},        {"kind", 1.7},
+    {"caring", 1.8},        {"warm", 1.6},
+    {"gentle", 1.6},        {"calm", 1.4},
+    {"peaceful", 1.7},      {"stable", 1.3},
+    {"consistent", 1.3},    {"trust", 1.8},
+    {"trusted", 1.8},       {"loyal", 1.8},
+    {"dedicated", 1.7},     {"confident", 1.7},
+    {"capable", 1.5},       {"skilled", 1.6},
+    {"talented", 1.8},      {"clever", 1.7},
+    {"wise", 1.8},          {"experienced", 1.5},
+    {"professional", 1.6},  {"improve", 1.5},
+    {"improved", 1.5},      {"progress", 1.6},
+    {"recover", 1.5},       {"recovered", 1.5},
+    {"heal", 1.6},          {"cure", 1.7},
+    {"save", 1.5},          {"protect", 1.5},
+    {"support", 1.4},       {"help", 1.5},
+    {"helped", 1.5},        {"cooperate", 1.5},
+    {"unite", 1.5},         {"share", 1.3},
+    {"donate", 1.6},        {"volunteer", 1.7},
+
+    // ── Strong Negative (-3.0 ~ -3.5) ─────────────────────────
+    {"terrible", -3.5},     {"horrible", -3.5},
+    {"awful", -3.4},        {"disgusting", -3.3},
+    {"abysmal", -3.2},      {"appalling", -3.2},
+    {"catastrophic", -3.1}, {"disastrous", -3.1},
+    {"dreadful", -2.9},     {"atrocious", -3.2},
+    {"despicable", -3.0},   {"horrendous", -3.3},
+    {"hideous", -2.9},      {"vile", -3.0},
+    {"wretched", -2.9},     {"deplorable", -3.0},
+    {"outrageous", -2.8},   {"intolerable", -2.9},
+    {"unbearable", -2.8},   {"insufferable", -2.8},
+
+    // ── Moderate Negative (-2.0 ~ -2.9) ───────────────────────
+    {"bad", -2.0},          {"poor", -2.0},
+    {"hate", -2.5},         {"hated", -2.5},
+    {"worst", -2.7},        {"worse", -1.9},
+    {"sad", -2.0},          {"unhappy", -2.1},
+    {"angry", -2.2},        {"anger", -2.2},
+    {"furious", -2.6},      {"rage", -2.6},
+    {"enraged", -2.7},      {"livid", -2.5},
+    {"disappointed", -2.1}, {"disappointing", -2.1},
+    {"disappointment", -2.1},
+    {"frustrated", -2.0},   {"frustrating", -2.0},
+    {"frustration", -2.0},  {"annoying", -1.8},
+    {"annoyed", -1.8},      {"irritated", -1.9},
+    {"aggravating", -2.0},  {"waste", -2.0},
+    {"broken", -2.0},       {"fail", -2.1},
+    {"failed", -2.1},       {"failure", -2.1},
+    {"ugly", -2.0},         {"rude", -2.1},
+    {"useless", -2.2},      {"worthless", -2.3},
+    {"painful", -2.0},      {"pain", -1.9},
+    {"scam", -3.0},         {"fraud", -3.0},
+    {"lie", -2.5},          {"lied", -2.5},
+    {"cheat", -2.7},        {"cheated", -2.7},
+    {"steal", -2.6},        {"corrupt", -2.8},
+    {"corruption", -2.8},   {"depressed", -2.4},
+    {"miserable", -2.5},    {"hopeless", -2.3},
+    {"desperate", -2.3},    {"devastated", -2.6},
+    {"heartbroken", -2.5},  {"crushed", -2.4},
+    {"destroyed", -2.5},    {"ruined", -2.4},
+
+    // ── Mild Negative (-0.5 ~ -1.9) ───────────────────────────
+    {"boring", -1.7},       {"bored", -1.6},
+    {"dirty", -1.8},        {"slow", -1.5},
+    {"sick", -1.8},         {"problem", -1.5},
+    {"crash", -2.0},        {"wrong", -1.7},
+    {"confusing", -1.5},    {"regret", -2.1},
+    {"mediocre", -1.2},     {"unreliable", -1.5},
+    {"expensive", -1.2},    {"fear", -2.0},
+    {"scared", -1.9},       {"worried", -1.8},
+    {"stress", -1.8},       {"stressed", -1.8},
+    {"shame", -2.0},        {"guilt", -1.9},
+    {"lonely", -2.0},       {"alone", -1.5},
+    {"tired", -1.4},        {"exhausted", -1.7},
+    {"weak", -1.5},         {"helpless", -2.0},
+    {"inferior", -1.8},     {"inadequate", -1.7},
+    {"incompetent", -1.9},  {"lazy", -1.5},
+    {"careless", -1.6},     {"irresponsible", -1.9},
+    {"unfair", -1.8},       {"unjust", -1.9},
+    {"selfish", -1.8},      {"greedy", -1.9},
+    {"cruel", -2.3},        {"harsh", -1.7},
+    {"toxic", -2.2},        {"harmful", -2.0},
+    {"dangerous", -1.9},    {"risky", -1.5},
+    {"uncertain", -1.2},    {"unstable", -1.5},
+    {"difficult", -1.2},    {"complicated", -1.1},
+    {"doubt", -1.3},        {"suspicious", -1.5},
+    {"nervous", -1.6},      {"anxious", -1.8},
+    {"panic", -2.0},        {"terror", -2.5},
+    {"horror", -2.4},       {"nightmare", -2.3},
+    {"dread", -2.1},        {"paranoid", -1.9},
+    {"insecure", -1.7},     {"grief", -2.2},
+    {"sorrow", -2.1},       {"mourn", -2.0},
+    {"cry", -1.6},          {"weep", -1.8},
+    {"suffer", -2.2},       {"suffering", -2.2},
+    {"struggle", -1.6},     {"burden", -1.7},
+    {"reject", -1.9},       {"rejected", -2.0},
+    {"ignore", -1.5},       {"ignored", -1.6},
+    {"abandon", -2.1},      {"abandoned", -2.2},
+    {"betray", -2.5},       {"betrayed", -2.5},
+    {"neglect", -1.8}
+});
+
+inline constexpr auto SENT_INTENSIFIERS = makePerfectMap<double>({
+    {"very", 1.3},          {"extremely", 1.5},
+    {"incredibly", 1.5},    {"absolutely", 1.4},
+    {"totally", 1.3},       {"completely", 1.3},
+    {"highly", 1.3},        {"deeply", 1.3},
+    {"really", 1.2},        {"so", 1.2},
+    {"quite", 1.1},         {"pretty", 1.1},
+    {"exceptionally", 1.5}, {"remarkably", 1.4},
+    {"terribly", 1.4},      {"awfully", 1.4},
+    {"insanely", 1.4},      {"unbelievably", 1.4},
+    {"truly", 1.2},         {"genuinely", 1.2},
+    {"definitely", 1.2},    {"especially", 1.2},
+    {"particularly", 1.2}
+});
+
+// diminisher: sentiment কে দুর্বল করে
+// "kind of bad" → bad × 0.6
+inline constexpr auto SENT_DIMINISHERS = makePerfectMap<double>({
+    {"somewhat", 0.7},      {"slightly", 0.6},
+    {"fairly", 0.8},        {"rather", 0.8},
+    {"mildly", 0.6},        {"moderately", 0.7},
+    {"partially", 0.6},     {"almost", 0.8},
+    {"nearly", 0.8},        {"barely", 0.4},
+    {"just", 0.7},          {"only", 0.7},
+    {"average", 0.6},       {"kinda", 0.6}
+});
+
+// emotionMap এর মান — alphabetical ক্রমে, কারণ সমান count হলে
+// আগের নামটা জেতে (পুরনো map<string,int> এর max_element এর মতো)
+enum class Emotion : uint8_t
+{
+    Anger, Anticipation, Disgust, Fear, Joy, Sadness, Surprise, Trust, Neutral
+};
+constexpr int EMOTION_COUNT = (int)Emotion::Neutral;
+constexpr string_view EMOTION_NAMES[] = {
+    "Anger", "Anticipation", "Disgust", "Fear", "Joy", "Sadness", "Surprise", "Trust", "Neutral"
+};
+
+inline constexpr auto SENT_EMOTIONS = makePerfectMap<Emotion>({
+    // Joy
+    {"happy", Emotion::Joy},          {"joy", Emotion::Joy},
+    {"excited", Emotion::Joy},        {"love", Emotion::Joy},
+    {"delight", Emotion::Joy},        {"cheerful", Emotion::Joy},
+    {"great", Emotion::Joy},          {"wonderful", Emotion::Joy},
+    {"fun", Emotion::Joy},            {"funny", Emotion::Joy},
+    {"joyful", Emotion::Joy},         {"celebrate", Emotion::Joy},
+    {"glad", Emotion::Joy},           {"pleased", Emotion::Joy},
+    {"blessed", Emotion::Joy},        {"grateful", Emotion::Joy},
+    {"thankful", Emotion::Joy},       {"thrilled", Emotion::Joy},
+    {"ecstatic", Emotion::Joy},       {"elated", Emotion::Joy},
+    {"bliss", Emotion::Joy},
+
+    // Anger
+    {"angry", Emotion::Anger},        {"hate", Emotion::Anger},
+    {"frustrated", Emotion::Anger},   {"annoyed", Emotion::Anger},
+    {"rage", Emotion::Anger},         {"furious", Emotion::Anger},
+    {"rude", Emotion::Anger},         {"enraged", Emotion::Anger},
+    {"livid", Emotion::Anger},        {"outraged", Emotion::Anger},
+    {"hostile", Emotion::Anger},      {"bitter", Emotion::Anger},
+    {"resentful", Emotion::Anger},    {"scam", Emotion::Anger},
+    {"cheat", Emotion::Anger},        {"corrupt", Emotion::Anger},
+
+    // Sadness
+    {"sad", Emotion::Sadness},        {"unhappy", Emotion::Sadness},
+    {"depressed", Emotion::Sadness},  {"lonely", Emotion::Sadness},
+    {"miserable", Emotion::Sadness},  {"hopeless", Emotion::Sadness},
+    {"disappointed", Emotion::Sadness},{"regret", Emotion::Sadness},
+    {"grief", Emotion::Sadness},      {"sorrow", Emotion::Sadness},
+    {"mourn", Emotion::Sadness},      {"cry", Emotion::Sadness},
+    {"weep", Emotion::Sadness},       {"heartbroken", Emotion::Sadness},
+    {"devastated", Emotion::Sadness}, {"crushed", Emotion::Sadness},
+    {"abandoned", Emotion::Sadness},  {"betrayed", Emotion::Sadness},
+
+    // Fear
+    {"scared", Emotion::Fear},        {"fear", Emotion::Fear},
+    {"worried", Emotion::Fear},       {"anxious", Emotion::Fear},
+    {"terrified", Emotion::Fear},     {"nervous", Emotion::Fear},
+    {"panic", Emotion::Fear},         {"terror", Emotion::Fear},
+    {"horror", Emotion::Fear},        {"dread", Emotion::Fear},
+    {"paranoid", Emotion::Fear},      {"insecure", Emotion::Fear},
+    {"nightmare", Emotion::Fear},     {"helpless", Emotion::Fear},
+
+    // Surprise
+    {"amazing", Emotion::Surprise},   {"incredible", Emotion::Surprise},
+    {"unexpected", Emotion::Surprise},{"shocking", Emotion::Surprise},
+    {"awesome", Emotion::Surprise},   {"astonishing", Emotion::Surprise},
+    {"astounding", Emotion::Surprise},{"unbelievable", Emotion::Surprise},
+    {"stunning", Emotion::Surprise},  {"wow", Emotion::Surprise},
+
+    // Disgust
+    {"disgusting", Emotion::Disgust}, {"horrible", Emotion::Disgust},
+    {"awful", Emotion::Disgust},      {"terrible", Emotion::Disgust},
+    {"nasty", Emotion::Disgust},      {"ugly", Emotion::Disgust},
+    {"vile", Emotion::Disgust},       {"revolting", Emotion::Disgust},
+    {"repulsive", Emotion::Disgust},  {"gross", Emotion::Disgust},
+    {"filthy", Emotion::Disgust},     {"toxic", Emotion::Disgust},
+
+    // Trust (NEW)
+    {"trust", Emotion::Trust},        {"trusted", Emotion::Trust},
+    {"reliable", Emotion::Trust},     {"honest", Emotion::Trust},
+    {"loyal", Emotion::Trust},        {"faithful", Emotion::Trust},
+    {"dependable", Emotion::Trust},   {"responsible", Emotion::Trust},
+    {"credible", Emotion::Trust},     {"integrity", Emotion::Trust},
+
+    // Anticipation (NEW)
+    {"hope", Emotion::Anticipation},  {"hopeful", Emotion::Anticipation},
+    {"eager", Emotion::Anticipation}, {"await", Emotion::Anticipation},
+    {"anticipate", Emotion::Anticipation},{"expect", Emotion::Anticipation},
+    {"plan", Emotion::Anticipation},  {"goal", Emotion::Anticipation},
+    {"forward", Emotion::Anticipation}
+});
+
+inline constexpr auto SENT_NEGATIONS = makePerfectSet({
+    "not","no","never","neither","nor","nothing","nobody",
+    "nowhere","without","dont","doesnt","didnt","wasnt","werent",
+    "isnt","arent","cant","cannot","wont","wouldnt","shouldnt",
+    "couldnt","hardly","barely","scarcely","rarely","seldom",
+    "few","little","lack","lacking","absence","absent",
+    "deny","denied","refuse","refused"
+});
+
+// contrast conjunction: "but" এর পরের sentiment এর weight বাড়ে
+inline constexpr auto SENT_CONTRASTS = makePerfectSet({
+    "but","however","although","though","despite","yet",
+    "nevertheless","nonetheless","still","except",
+    "whereas","while","alternatively","conversely"
+});
 
 struct SentimentResult
 {
@@ -318,405 +563,140 @@ struct SentimentResult
     string emotion;      // Joy/Anger/Sadness/Fear/Surprise/Disgust/Trust/Anticipation
 };
 
-class SentimentAnalyzer
-{
-private:
-    map<string, double> lexicon;
-    map<string, double> intensifiers;
-    map<string, double> diminishers;
-    map<string, string> emotionMap;
-    set<string>         negWords;
-    set<string>         contrastWords;
-
-    void buildLexicon()
-    {
-        // ── Strong Positive (3.0 ~ 3.5) ───────────────────────────
-        lexicon["excellent"]=3.5;    lexicon["outstanding"]=3.5;
-        lexicon["exceptional"]=3.5;  lexicon["extraordinary"]=3.4;
-        lexicon["amazing"]=3.4;      lexicon["fantastic"]=3.4;
-        lexicon["wonderful"]=3.3;    lexicon["brilliant"]=3.3;
-        lexicon["superb"]=3.2;       lexicon["perfect"]=3.1;
-        lexicon["incredible"]=3.1;   lexicon["phenomenal"]=3.0;
-        lexicon["magnificent"]=3.0;  lexicon["marvelous"]=2.9;
-        lexicon["spectacular"]=2.9;  lexicon["splendid"]=2.8;
-        lexicon["glorious"]=2.8;     lexicon["sublime"]=2.8;
-        lexicon["flawless"]=3.0;     lexicon["masterpiece"]=3.2;
-        lexicon["legendary"]=3.0;    lexicon["breathtaking"]=3.1;
-        lexicon["astounding"]=3.0;   lexicon["remarkable"]=2.8;
-
-        // ── Moderate Positive (2.0 ~ 2.9) ─────────────────────────
-        lexicon["awesome"]=2.8;      lexicon["great"]=2.5;
-        lexicon["love"]=2.5;         lexicon["loved"]=2.5;
-        lexicon["loving"]=2.4;       lexicon["best"]=2.6;
-        lexicon["happy"]=2.1;        lexicon["happiness"]=2.2;
-        lexicon["joy"]=2.3;          lexicon["joyful"]=2.3;
-        lexicon["joyous"]=2.3;       lexicon["excited"]=2.2;
-        lexicon["exciting"]=2.2;     lexicon["delight"]=2.2;
-        lexicon["delightful"]=2.2;   lexicon["cheerful"]=2.0;
-        lexicon["enjoy"]=2.0;        lexicon["enjoyed"]=2.0;
-        lexicon["enjoyable"]=2.0;    lexicon["fun"]=2.0;
-        lexicon["funny"]=2.0;        lexicon["impressive"]=2.3;
-        lexicon["pleased"]=2.0;      lexicon["glad"]=1.9;
-        lexicon["recommend"]=1.9;    lexicon["winning"]=2.0;
-        lexicon["win"]=2.0;          lexicon["won"]=2.0;
-        lexicon["charming"]=2.0;     lexicon["elegant"]=2.1;
-        lexicon["graceful"]=2.0;     lexicon["vibrant"]=2.0;
-        lexicon["thrilling"]=2.3;    lexicon["inspiring"]=2.2;
-        lexicon["motivated"]=2.0;    lexicon["energetic"]=2.0;
-        lexicon["enthusiastic"]=2.1; lexicon["passionate"]=2.1;
-        lexicon["proud"]=2.0;        lexicon["grateful"]=2.1;
-        lexicon["thankful"]=2.0;     lexicon["blessed"]=2.2;
-        lexicon["fortunate"]=2.0;    lexicon["lucky"]=1.9;
-        lexicon["celebrate"]=2.1;    lexicon["celebration"]=2.1;
-        lexicon["triumph"]=2.3;      lexicon["victorious"]=2.4;
-        lexicon["achievement"]=2.2;  lexicon["accomplished"]=2.1;
-        lexicon["succeed"]=2.1;      lexicon["success"]=2.1;
-        lexicon["successful"]=2.1;   lexicon["innovative"]=2.0;
-        lexicon["creative"]=1.8;
-
-        // ── Mild Positive (0.5 ~ 1.9) ─────────────────────────────
-        lexicon["good"]=2.0;         lexicon["nice"]=1.8;
-        lexicon["like"]=1.5;         lexicon["liked"]=1.5;
-        lexicon["better"]=1.8;       lexicon["helpful"]=1.8;
-        lexicon["useful"]=1.7;       lexicon["smart"]=1.8;
-        lexicon["efficient"]=1.8;    lexicon["reliable"]=1.8;
-        lexicon["honest"]=1.6;       lexicon["hope"]=1.7;
-        lexicon["hopeful"]=1.8;      lexicon["strong"]=1.5;
-        lexicon["healthy"]=1.7;      lexicon["comfortable"]=1.8;
-        lexicon["friendly"]=1.9;     lexicon["clean"]=1.5;
-        lexicon["smooth"]=1.7;       lexicon["worthy"]=1.6;
-        lexicon["safe"]=1.5;         lexicon["positive"]=1.9;
-        lexicon["beautiful"]=2.1;    lexicon["ok"]=0.9;
-        lexicon["okay"]=0.9;         lexicon["alright"]=0.8;
-        lexicon["fair"]=0.5;         lexicon["decent"]=1.2;
-        lexicon["reasonable"]=1.1;   lexicon["adequate"]=0.8;
-        lexicon["satisfactory"]=1.0; lexicon["acceptable"]=0.9;
-        lexicon["pleasant"]=1.7;     lexicon["pleasing"]=1.7;
-        lexicon["polite"]=1.6;       lexicon["kind"]=1.7;
-        lexicon["caring"]=1.8;       lexicon["warm"]=1.6;
-        lexicon["gentle"]=1.6;       lexicon["calm"]=1.4;
-        lexicon["peaceful"]=1.7;     lexicon["stable"]=1.3;
-        lexicon["consistent"]=1.3;   lexicon["trust"]=1.8;
-        lexicon["trusted"]=1.8;      lexicon["loyal"]=1.8;
-        lexicon["dedicated"]=1.7;    lexicon["confident"]=1.7;
-        lexicon["capable"]=1.5;      lexicon["skilled"]=1.6;
-        lexicon["talented"]=1.8;     lexicon["clever"]=1.7;
-        lexicon["wise"]=1.8;         lexicon["experienced"]=1.5;
-        lexicon["professional"]=1.6; lexicon["improve"]=1.5;
-        lexicon["improved"]=1.5;     lexicon["progress"]=1.6;
-        lexicon["recover"]=1.5;      lexicon["recovered"]=1.5;
-        lexicon["heal"]=1.6;         lexicon["cure"]=1.7;
-        lexicon["save"]=1.5;         lexicon["protect"]=1.5;
-        lexicon["support"]=1.4;      lexicon["help"]=1.5;
-        lexicon["helped"]=1.5;       lexicon["cooperate"]=1.5;
-        lexicon["unite"]=1.5;        lexicon["share"]=1.3;
-        lexicon["donate"]=1.6;       lexicon["volunteer"]=1.7;
-
-        // ── Strong Negative (-3.0 ~ -3.5) ─────────────────────────
-        lexicon["terrible"]=-3.5;    lexicon["horrible"]=-3.5;
-        lexicon["awful"]=-3.4;       lexicon["disgusting"]=-3.3;
-        lexicon["abysmal"]=-3.2;     lexicon["appalling"]=-3.2;
-        lexicon["catastrophic"]=-3.1;lexicon["disastrous"]=-3.1;
-        lexicon["dreadful"]=-2.9;    lexicon["atrocious"]=-3.2;
-        lexicon["despicable"]=-3.0;  lexicon["horrendous"]=-3.3;
-        lexicon["hideous"]=-2.9;     lexicon["vile"]=-3.0;
-        lexicon["wretched"]=-2.9;    lexicon["deplorable"]=-3.0;
-        lexicon["outrageous"]=-2.8;  lexicon["intolerable"]=-2.9;
-        lexicon["unbearable"]=-2.8;  lexicon["insufferable"]=-2.8;
-
-        // ── Moderate Negative (-2.0 ~ -2.9) ───────────────────────
-        lexicon["bad"]=-2.0;         lexicon["poor"]=-2.0;
-        lexicon["hate"]=-2.5;        lexicon["hated"]=-2.5;
-        lexicon["worst"]=-2.7;       lexicon["worse"]=-1.9;
-        lexicon["sad"]=-2.0;         lexicon["unhappy"]=-2.1;
-        lexicon["angry"]=-2.2;       lexicon["anger"]=-2.2;
-        lexicon["furious"]=-2.6;     lexicon["rage"]=-2.6;
-        lexicon["enraged"]=-2.7;     lexicon["livid"]=-2.5;
-        lexicon["disappointed"]=-2.1;lexicon["disappointing"]=-2.1;
-        lexicon["disappointment"]=-2.1;
-        lexicon["frustrated"]=-2.0;  lexicon["frustrating"]=-2.0;
-        lexicon["frustration"]=-2.0; lexicon["annoying"]=-1.8;
-        lexicon["annoyed"]=-1.8;     lexicon["irritated"]=-1.9;
-        lexicon["aggravating"]=-2.0; lexicon["waste"]=-2.0;
-        lexicon["broken"]=-2.0;      lexicon["fail"]=-2.1;
-        lexicon["failed"]=-2.1;      lexicon["failure"]=-2.1;
-        lexicon["ugly"]=-2.0;        lexicon["rude"]=-2.1;
-        lexicon["useless"]=-2.2;     lexicon["worthless"]=-2.3;
-        lexicon["painful"]=-2.0;     lexicon["pain"]=-1.9;
-        lexicon["scam"]=-3.0;        lexicon["fraud"]=-3.0;
-        lexicon["lie"]=-2.5;         lexicon["lied"]=-2.5;
-        lexicon["cheat"]=-2.7;       lexicon["cheated"]=-2.7;
-        lexicon["steal"]=-2.6;       lexicon["corrupt"]=-2.8;
-        lexicon["corruption"]=-2.8;  lexicon["depressed"]=-2.4;
-        lexicon["miserable"]=-2.5;   lexicon["hopeless"]=-2.3;
-        lexicon["desperate"]=-2.3;   lexicon["devastated"]=-2.6;
-        lexicon["heartbroken"]=-2.5; lexicon["crushed"]=-2.4;
-        lexicon["destroyed"]=-2.5;   lexicon["ruined"]=-2.4;
-
-        // ── Mild Negative (-0.5 ~ -1.9) ───────────────────────────
-        lexicon["boring"]=-1.7;      lexicon["bored"]=-1.6;
-        lexicon["dirty"]=-1.8;       lexicon["slow"]=-1.5;
-        lexicon["sick"]=-1.8;        lexicon["problem"]=-1.5;
-        lexicon["crash"]=-2.0;       lexicon["wrong"]=-1.7;
-        lexicon["confusing"]=-1.5;   lexicon["regret"]=-2.1;
-        lexicon["mediocre"]=-1.2;    lexicon["unreliable"]=-1.5;
-        lexicon["expensive"]=-1.2;   lexicon["fear"]=-2.0;
-        lexicon["scared"]=-1.9;      lexicon["worried"]=-1.8;
-        lexicon["stress"]=-1.8;      lexicon["stressed"]=-1.8;
-        lexicon["shame"]=-2.0;       lexicon["guilt"]=-1.9;
-        lexicon["lonely"]=-2.0;      lexicon["alone"]=-1.5;
-        lexicon["tired"]=-1.4;       lexicon["exhausted"]=-1.7;
-        lexicon["weak"]=-1.5;        lexicon["helpless"]=-2.0;
-        lexicon["inferior"]=-1.8;    lexicon["inadequate"]=-1.7;
-        lexicon["incompetent"]=-1.9; lexicon["lazy"]=-1.5;
-        lexicon["careless"]=-1.6;    lexicon["irresponsible"]=-1.9;
-        lexicon["unfair"]=-1.8;      lexicon["unjust"]=-1.9;
-        lexicon["selfish"]=-1.8;     lexicon["greedy"]=-1.9;
-        lexicon["cruel"]=-2.3;       lexicon["harsh"]=-1.7;
-        lexicon["toxic"]=-2.2;       lexicon["harmful"]=-2.0;
-        lexicon["dangerous"]=-1.9;   lexicon["risky"]=-1.5;
-        lexicon["uncertain"]=-1.2;   lexicon["unstable"]=-1.5;
-        lexicon["difficult"]=-1.2;   lexicon["complicated"]=-1.1;
-        lexicon["doubt"]=-1.3;       lexicon["suspicious"]=-1.5;
-        lexicon["nervous"]=-1.6;     lexicon["anxious"]=-1.8;
-        lexicon["panic"]=-2.0;       lexicon["terror"]=-2.5;
-        lexicon["horror"]=-2.4;      lexicon["nightmare"]=-2.3;
-        lexicon["dread"]=-2.1;       lexicon["paranoid"]=-1.9;
-        lexicon["insecure"]=-1.7;    lexicon["grief"]=-2.2;
-        lexicon["sorrow"]=-2.1;      lexicon["mourn"]=-2.0;
-        lexicon["cry"]=-1.6;         lexicon["weep"]=-1.8;
-        lexicon["suffer"]=-2.2;      lexicon["suffering"]=-2.2;
-        lexicon["struggle"]=-1.6;    lexicon["burden"]=-1.7;
-        lexicon["reject"]=-1.9;      lexicon["rejected"]=-2.0;
-        lexicon["ignore"]=-1.5;      lexicon["ignored"]=-1.6;
-        lexicon["abandon"]=-2.1;     lexicon["abandoned"]=-2.2;
-        lexicon["betray"]=-2.5;      lexicon["betrayed"]=-2.5;
-        lexicon["neglect"]=-1.8;
-    }
-
-    void buildNegWords()
-    {
-        negWords = {
-            "not","no","never","neither","nor","nothing","nobody",
-            "nowhere","without","dont","doesnt","didnt","wasnt","werent",
-            "isnt","arent","cant","cannot","wont","wouldnt","shouldnt",
-            "couldnt","hardly","barely","scarcely","rarely","seldom",
-            "few","little","lack","lacking","absence","absent",
-            "deny","denied","refuse","refused"
-        };
-    }
-
-    void buildIntensifiers()
-    {
-        intensifiers["very"]=1.3;         intensifiers["extremely"]=1.5;
-        intensifiers["incredibly"]=1.5;   intensifiers["absolutely"]=1.4;
-        intensifiers["totally"]=1.3;      intensifiers["completely"]=1.3;
-        intensifiers["highly"]=1.3;       intensifiers["deeply"]=1.3;
-        intensifiers["really"]=1.2;       intensifiers["so"]=1.2;
-        intensifiers["quite"]=1.1;        intensifiers["pretty"]=1.1;
-        intensifiers["exceptionally"]=1.5;intensifiers["remarkably"]=1.4;
-        intensifiers["terribly"]=1.4;     intensifiers["awfully"]=1.4;
-        intensifiers["insanely"]=1.4;     intensifiers["unbelievably"]=1.4;
-        intensifiers["truly"]=1.2;        intensifiers["genuinely"]=1.2;
-        intensifiers["definitely"]=1.2;   intensifiers["especially"]=1.2;
-        intensifiers["particularly"]=1.2;
-    }
+enum class SentimentLabel : uint8_t     { Positive, Negative, Neutral };
+enum class SentimentIntensity : uint8_t { None, Slightly, Mildly, Moderately, Strongly };
+constexpr string_view LABEL_NAMES[]     = { "POSITIVE", "NEGATIVE", "NEUTRAL" };
+constexpr string_view INTENSITY_NAMES[] = { "", "Slightly", "Mildly", "Moderately", "Strongly" };
 
-    // diminisher: sentiment কে দুর্বল করে
-    // "kind of bad" → bad × 0.6
-    void buildDiminishers()
-    {
-        diminishers["somewhat"]=0.7;  diminishers["slightly"]=0.6;
-        diminishers["fairly"]=0.8;    diminishers["rather"]=0.8;
-        diminishers["mildly"]=0.6;    diminishers["moderately"]=0.7;
-        diminishers["partially"]=0.6; diminishers["almost"]=0.8;
-        diminishers["nearly"]=0.8;    diminishers["barely"]=0.4;
-        diminishers["just"]=0.7;      diminishers["only"]=0.7;
-        diminishers["average"]=0.6;   diminishers["kinda"]=0.6;
-    }
+// analyzeBatch() এর compact result — কোনো string নেই, 24 byte।
+// Label/intensity/emotion এর নাম দরকার হলে তখন *Name() দিয়ে।
+struct SentimentScore
+{
+    float              score;
+    float              positive, negative, neutral;   // %
+    float              confidence;
+    SentimentLabel     label;
+    SentimentIntensity intensity;
+    Emotion            emotion;
+
+    string_view labelName()     const { return LABEL_NAMES[(int)label]; }
+    string_view intensityName() const { return INTENSITY_NAMES[(int)intensity]; }
+    string_view emotionName()   const { return EMOTION_NAMES[(int)emotion]; }
+};
 
-    // contrast conjunction: "but" এর পরের sentiment এর weight বাড়ে
-    void buildContrastWords()
-    {
-        contrastWords = {
-            "but","however","although","though","despite","yet",
-            "nevertheless","nonetheless","still","except",
-            "whereas","while","alternatively","conversely"
-        };
-    }
+// analyze() এর token প্রতি feature — norm আর table lookup একবারই হয়
+enum : uint8_t { SENT_TOK_LEXICON = 1, SENT_TOK_NEGATION = 2, SENT_TOK_CONTRAST = 4, SENT_TOK_CAPS = 8 };
 
-    void buildEmotionMap()
-    {
-        // Joy
-        emotionMap["happy"]="Joy";        emotionMap["joy"]="Joy";
-        emotionMap["excited"]="Joy";      emotionMap["love"]="Joy";
-        emotionMap["delight"]="Joy";      emotionMap["cheerful"]="Joy";
-        emotionMap["great"]="Joy";        emotionMap["wonderful"]="Joy";
-        emotionMap["fun"]="Joy";          emotionMap["funny"]="Joy";
-        emotionMap["joyful"]="Joy";       emotionMap["celebrate"]="Joy";
-        emotionMap["glad"]="Joy";         emotionMap["pleased"]="Joy";
-        emotionMap["blessed"]="Joy";      emotionMap["grateful"]="Joy";
-        emotionMap["thankful"]="Joy";     emotionMap["thrilled"]="Joy";
-        emotionMap["ecstatic"]="Joy";     emotionMap["elated"]="Joy";
-        emotionMap["bliss"]="Joy";
-
-        // Anger
-        emotionMap["angry"]="Anger";      emotionMap["hate"]="Anger";
-        emotionMap["frustrated"]="Anger"; emotionMap["annoyed"]="Anger";
-        emotionMap["rage"]="Anger";       emotionMap["furious"]="Anger";
-        emotionMap["rude"]="Anger";       emotionMap["enraged"]="Anger";
-        emotionMap["livid"]="Anger";      emotionMap["outraged"]="Anger";
-        emotionMap["hostile"]="Anger";    emotionMap["bitter"]="Anger";
-        emotionMap["resentful"]="Anger";  emotionMap["scam"]="Anger";
-        emotionMap["cheat"]="Anger";      emotionMap["corrupt"]="Anger";
-
-        // Sadness
-        emotionMap["sad"]="Sadness";      emotionMap["unhappy"]="Sadness";
-        emotionMap["depressed"]="Sadness";emotionMap["lonely"]="Sadness";
-        emotionMap["miserable"]="Sadness";emotionMap["hopeless"]="Sadness";
-        emotionMap["disappointed"]="Sadness";emotionMap["regret"]="Sadness";
-        emotionMap["grief"]="Sadness";    emotionMap["sorrow"]="Sadness";
-        emotionMap["mourn"]="Sadness";    emotionMap["cry"]="Sadness";
-        emotionMap["weep"]="Sadness";     emotionMap["heartbroken"]="Sadness";
-        emotionMap["devastated"]="Sadness";emotionMap["crushed"]="Sadness";
-        emotionMap["abandoned"]="Sadness";emotionMap["betrayed"]="Sadness";
-
-        // Fear
-        emotionMap["scared"]="Fear";      emotionMap["fear"]="Fear";
-        emotionMap["worried"]="Fear";     emotionMap["anxious"]="Fear";
-        emotionMap["terrified"]="Fear";   emotionMap["nervous"]="Fear";
-        emotionMap["panic"]="Fear";       emotionMap["terror"]="Fear";
-        emotionMap["horror"]="Fear";      emotionMap["dread"]="Fear";
-        emotionMap["paranoid"]="Fear";    emotionMap["insecure"]="Fear";
-        emotionMap["nightmare"]="Fear";   emotionMap["helpless"]="Fear";
-
-        // Surprise
-        emotionMap["amazing"]="Surprise"; emotionMap["incredible"]="Surprise";
-        emotionMap["unexpected"]="Surprise";emotionMap["shocking"]="Surprise";
-        emotionMap["awesome"]="Surprise"; emotionMap["astonishing"]="Surprise";
-        emotionMap["astounding"]="Surprise";emotionMap["unbelievable"]="Surprise";
-        emotionMap["stunning"]="Surprise";emotionMap["wow"]="Surprise";
-
-        // Disgust
-        emotionMap["disgusting"]="Disgust";emotionMap["horrible"]="Disgust";
-        emotionMap["awful"]="Disgust";    emotionMap["terrible"]="Disgust";
-        emotionMap["nasty"]="Disgust";    emotionMap["ugly"]="Disgust";
-        emotionMap["vile"]="Disgust";     emotionMap["revolting"]="Disgust";
-        emotionMap["repulsive"]="Disgust";emotionMap["gross"]="Disgust";
-        emotionMap["filthy"]="Disgust";   emotionMap["toxic"]="Disgust";
-
-        // Trust (NEW)
-        emotionMap["trust"]="Trust";      emotionMap["trusted"]="Trust";
-        emotionMap["reliable"]="Trust";   emotionMap["honest"]="Trust";
-        emotionMap["loyal"]="Trust";      emotionMap["faithful"]="Trust";
-        emotionMap["dependable"]="Trust"; emotionMap["responsible"]="Trust";
-        emotionMap["credible"]="Trust";   emotionMap["integrity"]="Trust";
-
-        // Anticipation (NEW)
-        emotionMap["hope"]="Anticipation";emotionMap["hopeful"]="Anticipation";
-        emotionMap["eager"]="Anticipation";emotionMap["await"]="Anticipation";
-        emotionMap["anticipate"]="Anticipation";emotionMap["expect"]="Anticipation";
-        emotionMap["plan"]="Anticipation";emotionMap["goal"]="Anticipation";
-        emotionMap["forward"]="Anticipation";
-    }
+struct SentToken
+{
+    double  weight  = 0;    // lexicon score
+    double  intens  = 0;    // intensifier multiplier, 0 = intensifier নয়
+    double  dimin   = 0;    // diminisher multiplier, 0 = diminisher নয়
+    uint8_t flags   = 0;
+    int8_t  emotion = -1;   // Emotion, -1 = নেই
+};
 
-    string norm(const string& w)
-    {
-        string r = "";
-        for (char c : w) if (isalpha(c)) r += tolower(c);
-        return r;
-    }
+// সব table এর সবচেয়ে লম্বা key এর চেয়ে লম্বা word কোথাও match করে না
+constexpr size_t SENT_MAX_WORD = 32;
 
-    string detectEmotion(const vector<string>& tokens)
+class SentimentAnalyzer
+{
+private:
+    // AnalyzedDocument এর প্রতিটা word classify করে — tokenize আগেই হয়ে গেছে
+    static void classify(const AnalyzedDocument& doc, vector<SentToken>& feats)
     {
-        map<string, int> emotionCount;
-        for (const string& t : tokens) {
-            string w = norm(t);
-            if (emotionMap.count(w))
-                emotionCount[emotionMap[w]]++;
+        feats.clear();
+        feats.reserve(doc.words.size());
+        for (size_t i = 0; i < doc.words.size(); i++) {
+            SentToken t;
+            string_view w = doc.words[i];
+            if (w.size() <= SENT_MAX_WORD) {
+                if (const double* v = SENT_LEXICON.find(w)) {
+                    t.weight = *v;
+                    t.flags |= SENT_TOK_LEXICON;
+                    if (doc.wordFlags[i] & DOC_WORD_CAPS) t.flags |= SENT_TOK_CAPS;
+                }
+                if (const double* m = SENT_INTENSIFIERS.find(w)) t.intens = *m;
+                if (const double* m = SENT_DIMINISHERS.find(w))  t.dimin  = *m;
+                if (SENT_NEGATIONS.contains(w)) t.flags |= SENT_TOK_NEGATION;
+                if (SENT_CONTRASTS.contains(w)) t.flags |= SENT_TOK_CONTRAST;
+                if (const Emotion* e = SENT_EMOTIONS.find(w)) t.emotion = (int8_t)*e;
+            }
+            feats.push_back(t);
         }
-        if (emotionCount.empty()) return "Neutral";
-        return max_element(emotionCount.begin(), emotionCount.end(),
-            [](const pair<string,int>& a, const pair<string,int>& b){
-                return a.second < b.second;
-            })->first;
     }
 
-    bool hasContrastBefore(const vector<string>& tokens, int i)
+    // evaluate() এর full-precision result; analyze() আর analyzeBatch()
+    // দুটোই এখান থেকে নিজের format বানায়
+    struct Detail
     {
-        for (int j = max(0, i-5); j < i; j++)
-            if (contrastWords.count(norm(tokens[j]))) return true;
-        return false;
-    }
-
-public:
-    SentimentAnalyzer()
-    {
-        buildLexicon();
-        buildNegWords();
-        buildIntensifiers();
-        buildDiminishers();
-        buildEmotionMap();
-        buildContrastWords();
-    }
-
-    SentimentResult analyze(const string& text)
+        double             score, positive, negative, neutral, confidence;
+        SentimentLabel     label;
+        SentimentIntensity intensity;
+        Emotion            emotion;
+    };
+
+    // এক pass এ token classify, তারপর এক pass এ scoring। Negation আর
+    // contrast এর 5-word window sliding counter, diminisher/intensifier
+    // শুধু আগের ২টা token দেখে — পুরো scoring token সংখ্যায় linear।
+    // কোনো member এ লেখে না; feats caller এর scratch।
+    Detail evaluate(const AnalyzedDocument& doc, vector<SentToken>& feats) const
     {
-        stringstream ss(text);
-        vector<string> tokens;
-        string w;
-        while (ss >> w) tokens.push_back(w);
+        const int qmarks = doc.qmarks, excmarks = doc.excmarks;
+        classify(doc, feats);
+        const int N = feats.size();
 
         double raw = 0.0, posSum = 0.0, negSum = 0.0;
         int cnt = 0;
-
-        int qmarks   = 0; for (char c : text) if (c=='?') qmarks++;
-        int excmarks = 0; for (char c : text) if (c=='!') excmarks++;
-
-        for (int i = 0; i < (int)tokens.size(); i++) {
-            string word = norm(tokens[i]);
-            if (word.empty() || !lexicon.count(word)) continue;
-
-            double ws = lexicon[word];
-            cnt++;
-
-            // Rule 1: ALL CAPS boost
-            bool allCaps = true;
-            for (char c : tokens[i])
-                if (isalpha(c) && !isupper(c)) { allCaps = false; break; }
-            if (allCaps && tokens[i].length() > 1)
-                ws *= (ws > 0) ? 1.25 : 0.8;
-
-            // Rule 2: Intensifier (1 word before)
-            if (i > 0 && intensifiers.count(norm(tokens[i-1])))
-                ws *= intensifiers[norm(tokens[i-1])];
-
-            // Rule 3: Diminisher (1-2 words before)
-            for (int j = max(0, i-2); j < i; j++)
-                if (diminishers.count(norm(tokens[j]))) {
-                    ws *= diminishers[norm(tokens[j])];
-                    break;
-                }
-
-            // Rule 4: Negation window — 5 words
-            for (int j = max(0, i-5); j < i; j++)
-                if (negWords.count(norm(tokens[j]))) { ws *= -0.74; break; }
-
-            // Rule 5: Contrast conjunction — "but" এর পরে 1.5x boost
-            if (hasContrastBefore(tokens, i))
-                ws *= 1.5;
-
-            // Rule 6: Exclamation amplify
-            if (excmarks > 0)
-                ws += (ws > 0 ? 1 : -1) * min(excmarks, 3) * 0.292;
-
-            // Rule 7: Question mark dampening — uncertain statement
-            if (qmarks > 0)
-                ws *= 0.85;
-
-            raw += ws;
-            if (ws > 0) posSum += ws;
-            if (ws < 0) negSum += fabs(ws);
+        int negWin = 0, conWin = 0;   // window [i-5, i) এ negation / contrast word
+        int emotionCount[EMOTION_COUNT] = {0};
+
+        for (int i = 0; i < N; i++) {
+            const SentToken& t = feats[i];
+            if (t.emotion >= 0) emotionCount[t.emotion]++;
+
+            if (t.flags & SENT_TOK_LEXICON) {
+                double ws = t.weight;
+                cnt++;
+
+                // Rule 1: ALL CAPS boost
+                if (t.flags & SENT_TOK_CAPS)
+                    ws *= (ws > 0) ? 1.25 : 0.8;
+
+                // Rule 2: Intensifier (1 word before)
+                if (i > 0 && feats[i-1].intens != 0)
+                    ws *= feats[i-1].intens;
+
+                // Rule 3: Diminisher (1-2 words before) — আগেরটা আগে
+                if (i >= 2 && feats[i-2].dimin != 0)      ws *= feats[i-2].dimin;
+                else if (i >= 1 && feats[i-1].dimin != 0) ws *= feats[i-1].dimin;
+
+                // Rule 4: Negation window — 5 words
+                if (negWin > 0) ws *= -0.74;
+
+                // Rule 5: Contrast conjunction — "but" এর পরে 1.5x boost
+                if (conWin > 0) ws *= 1.5;
+
+                // Rule 6: Exclamation amplify
+                if (excmarks > 0)
+                    ws += (ws > 0 ? 1 : -1) * min(excmarks, 3) * 0.292;
+
+                // Rule 7: Question mark dampening — uncertain statement
+                if (qmarks > 0)
+                    ws *= 0.85;
+
+                raw += ws;
+                if (ws > 0) posSum += ws;
+                if (ws < 0) negSum += fabs(ws);
+            }
+
+            // window এগোয়: i ঢোকে, i-5 বের হয়
+            negWin += (t.flags & SENT_TOK_NEGATION) != 0;
+            conWin += (t.flags & SENT_TOK_CONTRAST) != 0;
+            if (i >= 5) {
+                negWin -= (feats[i-5].flags & SENT_TOK_NEGATION) != 0;
+                conWin -= (feats[i-5].flags & SENT_TOK_CONTRAST) != 0;
+            }
         }
 
         double score = (cnt == 0) ? 0.0 : raw / sqrt(raw * raw + 15.0);
@@ -729,23 +709,81 @@ public:
         double pct   = posR + negR + neuR;
         posR /= pct; negR /= pct; neuR /= pct;
 
-        double confidence = min(1.0, (double)cnt / max(1,(int)tokens.size()));
+        double confidence = min(1.0, (double)cnt / max(1, N));
 
-        string label, intensity;
+        SentimentLabel label;
+        SentimentIntensity intensity;
         double a = fabs(score);
-        if      (score >=  0.05) label = "POSITIVE";
-        else if (score <= -0.05) label = "NEGATIVE";
-        else                      label = "NEUTRAL";
+        if      (score >=  0.05) label = SentimentLabel::Positive;
+        else if (score <= -0.05) label = SentimentLabel::Negative;
+        else                      label = SentimentLabel::Neutral;
+
+        if      (a >= 0.75) intensity = SentimentIntensity::Strongly;
+        else if (a >= 0.50) intensity = SentimentIntensity::Moderately;
+        else if (a >= 0.25) intensity = SentimentIntensity::Mildly;
+        else if (a >= 0.05) intensity = SentimentIntensity::Slightly;
+        else                 intensity = SentimentIntensity::None;
+
+        // সবচেয়ে বেশি count; সমান হলে alphabetical ক্রমে আগেরটা
+        int best = -1;
+        for (int e = 0; e < EMOTION_COUNT; e++)
+            if (emotionCount[e] > 0 && (best < 0 || emotionCount[e] > emotionCount[best])) best = e;
+        Emotion emotion = best < 0 ? Emotion::Neutral : (Emotion)best;
+
+        return {score, posR*100, negR*100, neuR*100, confidence, label, intensity, emotion};
+    }
 
-        if      (a >= 0.75) intensity = "Strongly";
-        else if (a >= 0.50) intensity = "Moderately";
-        else if (a >= 0.25) intensity = "Mildly";
-        else if (a >= 0.05) intensity = "Slightly";
-        else                 intensity = "";
+    static SentimentResult render(const Detail& r)
+    {
+        return {r.score, r.positive, r.negative, r.neutral, r.confidence,
+                string(LABEL_NAMES[(int)r.label]),
+                string(INTENSITY_NAMES[(int)r.intensity]),
+                string(EMOTION_NAMES[(int)r.emotion])};
+    }
 
-        string emotion = detectEmotion(tokens);
-        return {score, posR*100, negR*100, neuR*100,
-                confidence, label, intensity, emotion};
+    static SentimentScore compact(const Detail& r)
+    {
+        return {(float)r.score, (float)r.positive, (float)r.negative, (float)r.neutral,
+                (float)r.confidence, r.label, r.intensity, r.emotion};
+    }
+
+public:
+    SentimentResult analyze(const string& text) const
+    {
+        AnalyzedDocument doc;
+        scanWords(text, doc);
+        vector<SentToken> feats;
+        return render(evaluate(doc, feats));
+    }
+
+    // TextPreprocessor::analyze() / scanWords() এ আগেই scan করা document
+    SentimentResult analyze(const AnalyzedDocument& doc) const
+    {
+        vector<SentToken> feats;
+        return render(evaluate(doc, feats));
+    }
+
+    // অনেক text একসাথে, threads টা worker এ (0 = সব core)। Analyzer এর
+    // কোনো state নেই, তাই একটা analyzer ই সব thread share করে।
+    vector<SentimentScore> analyzeBatch(const vector<string>& texts, int threads = 0) const
+    {
+        vector<SentimentScore> out(texts.size());
+        parallelFor(texts.size(), resolveThreads(threads), [&](size_t i) {
+            AnalyzedDocument doc;
+            scanWords(texts[i], doc);
+            vector<SentToken> feats;
+            out[i] = compact(evaluate(doc, feats));
+        });
+        return out;
+    }
+
+    vector<SentimentScore> analyzeBatch(const vector<AnalyzedDocument>& docs, int threads = 0) const
+    {
+        vector<SentimentScore> out(docs.size());
+        parallelFor(docs.size(), resolveThreads(threads), [&](size_t i) {
+            vector<SentToken> feats;
+            out[i] = compact(evaluate(docs[i], feats));
+        });
+        return out;
     }
->>>>>>> 51c03b0
 };
\ No newline at end of file
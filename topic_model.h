@@ -2,25 +2,49 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <sstream>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <shared_mutex>
 #include <algorithm>
 #include <cmath>
 #include <random>
 #include <iomanip>
 #include <numeric>
 #include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <new>
+#include <limits>
+#include <thread>
+#include "mapped_file.h"
+#include "parallel.h"
+#include "perfect_hash.h"
+#include "document.h"
+#include "vocabulary.h"
 using namespace std;
 
 // ═══════════════════════════════════════════════════════════════════
 //  SECTION 1: PORTER STEMMER
 // ═══════════════════════════════════════════════════════════════════
+// Word টা নিজের fixed buffer এ কপি করে সেখানেই in-place কাজ করে —
+// heap allocation নেই (খুব লম্বা word ছাড়া), suffix তুলনা memcmp দিয়ে।
+// Stemmer object টা stack এ রাখা হয়, তাই thread গুলো কিছু share করে না।
 class PorterStemmer
 {
-    string b;
-    int k, j;
+    static const int STEM_BUF = 64;
+
+    char   buf[STEM_BUF];
+    string big;          // STEM_BUF এর চেয়ে লম্বা word এর জন্য
+    char*  b = buf + 1;  // b[-1] সবসময় '\0' — step2/step4 এর b[k-1] এর জন্য
+    int    k, j;
 
     bool cons(int i)
     {
@@ -69,17 +93,23 @@ class PorterStemmer
         return true;
     }
 
-    bool ends(const string& s)
+    // Suffix গুলো সব literal, তাই length compile time এ জানা
+    template <size_t N>
+    bool ends(const char (&s)[N])
     {
-        int l = s.length();
+        const int l = N - 1;
         if (l > k + 1) return false;
-        if (b.substr(k - l + 1, l) != s) return false;
+        if (memcmp(b + k - l + 1, s, l) != 0) return false;
         j = k - l;
         return true;
     }
 
-    void setto(const string& s) { b.replace(j+1, k-j, s); k = j + s.length(); }
-    void r(const string& s)     { if (m() > 0) setto(s); }
+    // b[j+1..k] কে s দিয়ে বদলায়; k এর পরের chars কখনো পড়া হয় না,
+    // আর সবচেয়ে বেশি এক char বাড়ে (at → ate), তাই buffer এ জায়গা থাকে
+    template <size_t N>
+    void setto(const char (&s)[N]) { memcpy(b + j + 1, s, N - 1); k = j + N - 1; }
+    template <size_t N>
+    void r(const char (&s)[N])     { if (m() > 0) setto(s); }
 
     void step1ab()
     {
@@ -166,110 +196,217 @@ class PorterStemmer
     void step5b() { if (b[k]=='l' && doublec(k) && m()>1) k--; }
 
 public:
-    string stem(const string& word)
+    // Return করা view stemmer এর নিজের buffer এ (ছোট word হলে input এই),
+    // পরের stem() call পর্যন্ত valid।
+    string_view stem(string_view word)
     {
         if (word.length() <= 2) return word;
-        b = word; k = word.length()-1; j = 0;
+        size_t n = word.length();
+        if (n + 2 <= (size_t)STEM_BUF) b = buf + 1;
+        else { big.assign(n + 2, '\0'); b = &big[1]; }
+        b[-1] = '\0';
+        memcpy(b, word.data(), n); k = n - 1; j = 0;
         step1ab(); step1c(); step2(); step3(); step4(); step5a(); step5b();
-        return b.substr(0, k+1);
+        return string_view(b, k+1);
+    }
+
+    string stem(const string& word) { return string(stem(string_view(word))); }
+};
+
+// Zipfian vocab এ অল্প কিছু word ই বেশিরভাগ token, তাই cleaned word →
+// stem একবার হিসাব করে রেখে দিই। Hash অনুযায়ী shard, প্রতিটায় একটা
+// shared_mutex — hit এ শুধু shared lock, অনেক thread একসাথে পড়তে পারে।
+// Key/value এর bytes shard এর নিজের chunk এ থাকে, কখনো move হয় না।
+class StemCache
+{
+    static constexpr int    SHARDS      = 16;
+    static constexpr size_t MAX_ENTRIES = 1 << 14;   // shard প্রতি; ভরে গেলে শুধু lookup
+    static constexpr size_t CHUNK       = 1 << 16;
+
+    struct Shard
+    {
+        shared_mutex                            mu;
+        unordered_map<string_view, string_view> map;
+        vector<unique_ptr<char[]>>              chunks;
+        size_t                                  used = CHUNK;
+
+        string_view store(string_view s)
+        {
+            if (s.size() > CHUNK - used) {
+                chunks.emplace_back(new char[max(CHUNK, s.size())]);
+                used = 0;
+            }
+            char* p = chunks.back().get() + used;
+            memcpy(p, s.data(), s.size());
+            used += s.size();
+            return string_view(p, s.size());
+        }
+    };
+    unique_ptr<Shard[]> shards{new Shard[SHARDS]};
+
+public:
+    StemCache() = default;
+    // copy করলে খালি cache — mutex copy করা যায় না, আর cache শুধু speed এর জন্য
+    StemCache(const StemCache&) : StemCache() {}
+    StemCache& operator=(const StemCache&) { return *this; }
+
+    // stemmer caller এর (stack এ); miss হলে তাকে দিয়েই stem করে cache এ রাখে
+    string_view stem(string_view word, PorterStemmer& stemmer)
+    {
+        Shard& sh = shards[hash<string_view>()(word) % SHARDS];
+        {
+            shared_lock<shared_mutex> lock(sh.mu);
+            auto it = sh.map.find(word);
+            if (it != sh.map.end()) return it->second;
+        }
+        string_view out = stemmer.stem(word);
+        unique_lock<shared_mutex> lock(sh.mu);
+        if (sh.map.size() < MAX_ENTRIES && !sh.map.count(word)) {
+            string_view key = sh.store(word);
+            string_view val = out == word ? key : sh.store(out);
+            sh.map.emplace(key, val);
+        }
+        return out;
     }
 };
 
 // ═══════════════════════════════════════════════════════════════════
 //  SECTION 2: TEXT PREPROCESSOR
 // ═══════════════════════════════════════════════════════════════════
+
+// Expanded stopword list — 120+ words
+// topic modeling এ common words filter করা হয় যাতে
+// শুধু meaningful content words থাকে। Compile time perfect hash table।
+inline constexpr auto STOP_WORDS = makePerfectSet({
+    // articles & prepositions
+    "the","a","an","of","in","on","at","to","for","by","with",
+    "from","into","onto","upon","over","under","about","above",
+    "below","between","among","through","during","before","after",
+    "without","within","along","across","behind","beyond","near",
+    // conjunctions
+    "and","or","but","nor","so","yet","both","either","neither",
+    "although","though","because","since","while","whereas","if",
+    "unless","until","when","whenever","where","wherever","whether",
+    // pronouns
+    "i","me","my","myself","we","our","ours","ourselves",
+    "you","your","yours","yourself","yourselves",
+    "he","him","his","himself","she","her","hers","herself",
+    "it","its","itself","they","them","their","theirs","themselves",
+    "this","that","these","those","which","who","whom","whose","what",
+    // auxiliary verbs
+    "is","are","was","were","be","been","being",
+    "have","has","had","having","do","does","did","doing",
+    "will","would","shall","should","may","might","must","can","could",
+    // common adverbs & fillers
+    "not","no","more","most","also","just","very","much","many",
+    "some","such","only","even","then","than","there","here",
+    "all","any","each","every","few","little","own","same","other",
+    "another","else","already","still","again","once","now","too",
+    "well","quite","rather","however","therefore","thus","hence",
+    "furthermore","moreover","meanwhile","instead","otherwise",
+    // short common words
+    "up","out","off","down","as","how","one","two","three",
+    "first","second","said","new","get","got","use","used","go",
+    "going","come","came","take","taken","make","made","see","seen",
+    "know","known","say","says","think","like","need","want","way",
+    "thing","things","time","day","year","people","man","woman"
+});
+
 class TextPreprocessor
 {
 private:
-    PorterStemmer stemmer;
-    set<string>   stopWords;
+    mutable StemCache   stemCache;   // const tokenize() থেকেও ভরে, নিজেই thread-safe
 
-public:
-    TextPreprocessor()
-    {
-<<<<<<< HEAD
-        string sw[] = {
-            "the","and","this","that","with","from","your","have","were",
-            "they","will","would","about","been","also","more","when","which",
-            "their","there","what","into","than","then","its","but","not",
-            "are","was","for","has","his","her","she","him","you","can",
-            "all","one","had","our","they","just","very","much","some",
-            "such","only","even","most","after","before","those","these",
-            "is","in","to","a","an","of","it","he","i","at","on","by"
-=======
-        // Expanded stopword list — 120+ words
-        // topic modeling এ common words filter করা হয় যাতে
-        // শুধু meaningful content words থাকে
-        vector<string> sw = {
-            // articles & prepositions
-            "the","a","an","of","in","on","at","to","for","by","with",
-            "from","into","onto","upon","over","under","about","above",
-            "below","between","among","through","during","before","after",
-            "without","within","along","across","behind","beyond","near",
-            // conjunctions
-            "and","or","but","nor","so","yet","both","either","neither",
-            "although","though","because","since","while","whereas","if",
-            "unless","until","when","whenever","where","wherever","whether",
-            // pronouns
-            "i","me","my","myself","we","our","ours","ourselves",
-            "you","your","yours","yourself","yourselves",
-            "he","him","his","himself","she","her","hers","herself",
-            "it","its","itself","they","them","their","theirs","themselves",
-            "this","that","these","those","which","who","whom","whose","what",
-            // auxiliary verbs
-            "is","are","was","were","be","been","being",
-            "have","has","had","having","do","does","did","doing",
-            "will","would","shall","should","may","might","must","can","could",
-            // common adverbs & fillers
-            "not","no","more","most","also","just","very","much","many",
-            "some","such","only","even","then","than","there","here",
-            "all","any","each","every","few","little","own","same","other",
-            "another","else","already","still","again","once","now","too",
-            "well","quite","rather","however","therefore","thus","hence",
-            "furthermore","moreover","meanwhile","instead","otherwise",
-            // short common words
-            "up","out","off","down","as","how","one","two","three",
-            "first","second","said","new","get","got","use","used","go",
-            "going","come","came","take","taken","make","made","see","seen",
-            "know","known","say","says","think","like","need","want","way",
-            "thing","things","time","day","year","people","man","woman"
->>>>>>> 51c03b0
-        };
-        for (const string& s : sw) stopWords.insert(s);
+    // text কে whitespace এ ভেঙে প্রতিটা word এর letter গুলো lowercase করে
+    // সরাসরি out.chars এ লেখে (stringstream >> + cleanWord এর সমান)।
+    // filter = true হলে tokenize(): ছোট/stopword বাদ, বাকিগুলো stem।
+    void scan(string_view text, TokenBuffer& out, bool filter) const
+    {
+        out.clear();
+        PorterStemmer stemmer;
+        size_t i = 0, n = text.size();
+        while (i < n) {
+            while (i < n && isspace((unsigned char)text[i])) i++;
+            size_t start = out.chars.size();
+            for (; i < n && !isspace((unsigned char)text[i]); i++)
+                if (isalpha((unsigned char)text[i]))
+                    out.chars += (char)tolower((unsigned char)text[i]);
+
+            string_view word(out.chars.data() + start, out.chars.size() - start);
+            if (word.empty() || (filter && (word.length() < 2 || isStopWord(word)))) {
+                out.chars.resize(start);
+                continue;
+            }
+            if (filter) {
+                string_view st = stemCache.stem(word, stemmer);
+                if (st.data() != word.data()) { out.chars.resize(start); out.chars.append(st); }
+            }
+            out.ends.push_back((uint32_t)out.chars.size());
+        }
     }
 
-    string cleanWord(const string& raw)
+public:
+    string cleanWord(const string& raw) const
     {
         string res = "";
         for (char c : raw) if (isalpha(c)) res += tolower(c);
         return res;
     }
 
-    string stemWord(const string& word) { return stemmer.stem(word); }
-    bool isStopWord(const string& word) { return stopWords.count(word) > 0; }
+    string stemWord(const string& word) const
+    {
+        PorterStemmer stemmer;
+        return string(stemCache.stem(word, stemmer));
+    }
+    bool isStopWord(string_view word) const { return STOP_WORDS.contains(word); }
+
+    // Hot path: caller এর buffer এ লেখে, token প্রতি কোনো string তৈরি হয় না
+    void tokenize(string_view text, TokenBuffer& out) const    { scan(text, out, true); }
+    void tokenizeRaw(string_view text, TokenBuffer& out) const { scan(text, out, false); }
 
-    vector<string> tokenize(const string& text)
+    vector<string> tokenize(const string& text) const
     {
-        vector<string> tokens;
-        stringstream ss(text);
-        string word;
-        while (ss >> word) {
-            string cleaned = cleanWord(word);
-            if (cleaned.length() >= 2 && !isStopWord(cleaned))
-                tokens.push_back(stemWord(cleaned));
+        TokenBuffer buf;
+        tokenize(text, buf);
+        return toStrings(buf);
+    }
+
+    vector<string> tokenizeRaw(const string& text) const
+    {
+        TokenBuffer buf;
+        tokenizeRaw(text, buf);
+        return toStrings(buf);
+    }
+
+    // Shared pipeline: একবার scan করে words/flags/punctuation (sentiment এর
+    // জন্য), তারপর সেই words থেকেই filter+stem করে stems (topic এর জন্য)।
+    // doc.stems আর tokenize(text) এর output একই।
+    void analyze(string_view text, AnalyzedDocument& doc) const
+    {
+        scanWords(text, doc);
+        doc.stems.clear();
+        PorterStemmer stemmer;
+        for (size_t i = 0; i < doc.words.size(); i++) {
+            string_view word = doc.words[i];
+            if (word.length() < 2 || isStopWord(word)) continue;
+            doc.stems.chars.append(stemCache.stem(word, stemmer));
+            doc.stems.ends.push_back((uint32_t)doc.stems.chars.size());
         }
-        return tokens;
     }
 
-    vector<string> tokenizeRaw(const string& text)
+    vector<AnalyzedDocument> analyzeBatch(const vector<string>& texts, int threads = 0) const
+    {
+        vector<AnalyzedDocument> docs(texts.size());
+        parallelFor(texts.size(), resolveThreads(threads),
+                    [&](size_t i) { analyze(texts[i], docs[i]); });
+        return docs;
+    }
+
+    static vector<string> toStrings(const TokenBuffer& buf)
     {
         vector<string> tokens;
-        stringstream ss(text);
-        string word;
-        while (ss >> word) {
-            string cleaned = cleanWord(word);
-            if (!cleaned.empty()) tokens.push_back(cleaned);
-        }
+        tokens.reserve(buf.size());
+        for (size_t i = 0; i < buf.size(); i++) tokens.emplace_back(buf[i]);
         return tokens;
     }
 };
@@ -299,253 +436,2173 @@ public:
 };
 
 // ═══════════════════════════════════════════════════════════════════
-//  SECTION 4: SUPERVISED LDA — TOPIC MODELING
+//  SECTION 4: COUNT MATRICES
+//  Sampler এর count গুলো একটাই contiguous, cache-line aligned buffer এ
+//  row-major রাখা হয় — প্রতি row এর জন্য আলাদা heap block নেই।
+//  SLDA_COUNT16 define করে compile করলে nw/nd 16-bit counter এ থাকে
+//  (প্রতি cell এ সর্বোচ্চ 65535), memory অর্ধেক হয়।
+// ═══════════════════════════════════════════════════════════════════
+#ifdef SLDA_COUNT16
+typedef uint16_t lda_count_t;
+#else
+typedef int32_t  lda_count_t;
+#endif
+
+// Token এর topic — SLDA_TOPIC32 define না করলে 16-bit (K ≤ 65535),
+// token প্রতি ২ byte। এর বেশি label লাগলে SLDA_TOPIC32 দিয়ে compile।
+#ifdef SLDA_TOPIC32
+typedef int32_t  lda_topic_t;
+#else
+typedef uint16_t lda_topic_t;
+#endif
+const int MAX_TOPICS = (int)numeric_limits<lda_topic_t>::max();
+
+const size_t CACHE_LINE = 64;
+
+template <class T>
+struct AlignedAllocator
+{
+    typedef T value_type;
+    AlignedAllocator() = default;
+    template <class U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        return (T*)::operator new(n * sizeof(T), align_val_t(CACHE_LINE));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p, align_val_t(CACHE_LINE)); }
+
+    template <class U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <class U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template <class T>
+class CountMatrix
+{
+    int nrows = 0, ncols = 0;
+    vector<T, AlignedAllocator<T>> cells;
+
+public:
+    void assign(int rows, int cols, T value = 0)
+    {
+        nrows = rows; ncols = cols;
+        cells.assign((size_t)rows * cols, value);
+    }
+    void clear() { nrows = ncols = 0; cells.clear(); cells.shrink_to_fit(); }
+    // নিচে নতুন zero row যোগ — পুরনো row জায়গাতেই থাকে, capacity দ্বিগুণ হয়
+    void growRows(int rows)
+    {
+        if (rows <= nrows) return;
+        nrows = rows;
+        cells.resize((size_t)rows * ncols, 0);
+    }
+
+    T*       row(int r)       { return cells.data() + (size_t)r * ncols; }
+    const T* row(int r) const { return cells.data() + (size_t)r * ncols; }
+    T&       operator()(int r, int c)       { return cells[(size_t)r * ncols + c]; }
+    const T& operator()(int r, int c) const { return cells[(size_t)r * ncols + c]; }
+
+    T*       data()       { return cells.data(); }
+    const T* data() const { return cells.data(); }
+    int    rows()  const { return nrows; }
+    int    cols()  const { return ncols; }
+    size_t size()  const { return cells.size(); }
+    size_t bytes() const { return cells.size() * sizeof(T); }
+};
+
+// ═══════════════════════════════════════════════════════════════════
+//  SECTION 5: SUPERVISED LDA — TOPIC MODELING
 // ═══════════════════════════════════════════════════════════════════
 
 const double LDA_ALPHA = 0.1;
 const double LDA_BETA  = 0.01;
-<<<<<<< HEAD
-const double LDA_ETA   = 150.0;
-=======
 const double LDA_ETA   = 5.0;   
->>>>>>> 51c03b0
 const int    LDA_ITER  = 1000;
 const int    BURN_IN   = 200;
 const int    THINNING  = 5;
 
-struct Document
+// Early stopping: পরপর দুই window এর গড় LL এর relative পার্থক্য
+// CONV_TOL এর নিচে নামলে chain mixed ধরা হয়
+const double CONV_TOL     = 1e-3;
+const int    CONV_WINDOW  = 20;
+const int    MIN_SAMPLES  = 40;
+
+// Streaming SVI trainer: step size ρ_t = (SVI_TAU0 + t)^-SVI_KAPPA, batch
+// এর প্রতিটা doc এর local update সর্বোচ্চ SVI_LOCAL_ITER বার বা γ এর গড়
+// বদল SVI_LOCAL_TOL এর নিচে নামা পর্যন্ত
+const int    SVI_BATCH      = 1024;
+const double SVI_TAU0       = 1024;
+const double SVI_KAPPA      = 0.7;
+const int    SVI_LOCAL_ITER = 50;
+const double SVI_LOCAL_TOL  = 1e-3;
+
+// Binary model file: "SLDA" magic + version, তারপর hyperparameters,
+// labels, vocab আর averaged counts। Count block গুলো 8-byte aligned
+// যাতে mmap করা file থেকে সরাসরি double হিসেবে পড়া যায়।
+// Version 2 শেষে V×K float log-phi table যোগ করে; version 1 file load
+// করলে table টা load এর সময় বানানো হয়।
+const char     MODEL_MAGIC[4] = {'S','L','D','A'};
+const uint32_t MODEL_VERSION  = 2;
+
+// Checkpoint file: "SLCK" magic + version, corpus fingerprint, loop state
+// (iteration, burn-in, LL history), RNG, তারপর token topics, nwsum_acc আর
+// nw_acc (training চলাকালের correction form এ)। nw/nd/nwsum/ndsum topics
+// থেকে আবার গোনা যায়, তাই লেখা হয় না।
+const char     CKPT_MAGIC[4] = {'S','L','C','K'};
+const uint32_t CKPT_VERSION  = 1;
+
+// Out-of-core token shard: "SLSH" magic + version, docs, topic width, tokens,
+// তারপর Corpus এর মতোই CSR — offsets (u64, docs+1, shard এর ভেতরে 0 থেকে),
+// labels, words, topics। প্রতিটা block natural alignment এ, তাই mmap থেকে
+// সরাসরি DocSpan হয়। Default shard ~4M token (~28MB)।
+const char     SHARD_MAGIC[4] = {'S','L','S','H'};
+const uint32_t SHARD_VERSION  = 1;
+const size_t   SHARD_TOKENS   = 1 << 22;
+
+// Sampler thread প্রতি reusable buffer — token প্রতি কোনো allocation নেই
+struct SamplerScratch
+{
+    vector<double> cum;      // cumulative topic weights
+    vector<double> invDen;   // 1 / (nwsum[k] + V*beta), incrementally updated
+};
+
+// Dense: পুরো O(K) conditional থেকে exact Gibbs draw।
+// MH: LightLDA-style Metropolis-Hastings — word proposal ∝ nw[w][k] + beta,
+// doc proposal ∝ nd[d][k] + alpha, দুটোই একই word/doc এর অন্য একটা token
+// এর topic তুলে O(1) এ draw হয়; token প্রতি খরচ O(mhSteps), K নিরপেক্ষ।
+enum class SamplerType { Dense, MH };
+
+// MH sampler এর word proposal এর জন্য tokens এর topic, word অনুযায়ী
+// সাজানো (CSR) — word এর অন্য একটা token এর topic এক memory access এ পড়া যায়
+struct WordTokenIndex
+{
+    vector<int>         tokPos;     // global token id (Corpus এ position) → wordTopic এ position
+    vector<int>         wordOff;    // word w এর tokens: wordTopic[wordOff[w] .. wordOff[w+1])
+    vector<lda_topic_t> wordTopic;  // serial: current topic; parallel: sweep শুরুর snapshot
+
+    void clear() { *this = WordTokenIndex(); }
+};
+
+// শেষ sample এর পরে nw এর যে cell গুলো বদলেছে, প্রথম বদলের আগের মান সহ।
+// Bitmap cell প্রতি ১ bit, তাই sweep এর check টা cache এই থাকে।
+// resetSparse(): bitmap এর বদলে hash set — অল্প cell বদলালে (addDocuments)
+// খরচ বদলানো cell এর অনুপাতে, V×K এর নয়।
+struct DirtyCells
+{
+    vector<uint64_t>               bits;
+    unordered_set<size_t>          seen;   // sparse mode
+    bool                           sparse = false;
+    vector<pair<size_t, int32_t>>  list;   // (cell, period শুরুর মান)
+
+    void reset(size_t cells) { bits.assign((cells + 63) / 64, 0); list.clear(); sparse = false; }
+    void resetSparse()       { *this = DirtyCells(); sparse = true; }
+    void mark(size_t c, int32_t before)
+    {
+        if (sparse) {
+            if (!seen.insert(c).second) return;
+        } else {
+            uint64_t m = 1ull << (c & 63);
+            if (bits[c >> 6] & m) return;
+            bits[c >> 6] |= m;
+        }
+        list.push_back({c, before});
+    }
+    void clear() { *this = DirtyCells(); }
+};
+
+// lgamma() global signgam এ লেখে — trainChains() এর chain গুলো একসাথে LL
+// হিসাব করে, তাই যেখানে আছে সেখানে reentrant lgamma_r
+inline double logGamma(double x)
+{
+#if defined(__GLIBC__) || defined(__APPLE__)
+    int sign;
+    return lgamma_r(x, &sign);
+#else
+    return lgamma(x);
+#endif
+}
+
+// ψ(x) = d/dx log Γ(x), x > 0: ছোট x কে recurrence ψ(x) = ψ(x+1) - 1/x দিয়ে
+// ৬ এর উপরে তুলে asymptotic series — SVI এর E[log β] এর জন্য
+inline double digamma(double x)
+{
+    double r = 0;
+    while (x < 6) { r -= 1 / x; x += 1; }
+    double f = 1 / (x * x);
+    return r + log(x) - 0.5 / x
+         - f * (1.0 / 12 - f * (1.0 / 120 - f * (1.0 / 252 - f * (1.0 / 240 - f / 132))));
+}
+
+// predictBatch() এর result — topic id আর সেই topic এর log-likelihood score।
+// Vocab এর কোনো word না থাকলে TOPIC_UNKNOWN, model train না হলে TOPIC_NOT_TRAINED।
+const int TOPIC_UNKNOWN     = -1;
+const int TOPIC_NOT_TRAINED = -2;
+
+struct TopicPrediction
+{
+    int    topic = TOPIC_UNKNOWN;
+    double score = 0;
+};
+
+// selectFeatures() এর settings — default এ কোনো word বাদ যায় না
+struct FeatureSelection
+{
+    int    minDocFreq  = 1;     // এর কম document এ থাকা word বাদ (2 = hapax বাদ)
+    double maxDocRatio = 1.0;   // এর বেশি অংশ document এ থাকা word বাদ
+    int    topPerLabel = 0;     // > 0: প্রতিটা label এর TF-IDF এ সেরা N word এর union
+    int    maxVocab    = 0;     // > 0: বাকিদের মধ্যে সবচেয়ে frequent এতগুলো
+};
+
+// সব document এর token একটা CSR layout এ — doc d এর token গুলো
+// words/topics এর [offsets[d], offsets[d+1]) এ। Document প্রতি কোনো
+// আলাদা heap block নেই, sampler পুরো corpus একটানা সামনে পড়ে যায়।
+struct Corpus
+{
+    vector<uint64_t>    offsets{0};   // D+1
+    vector<int32_t>     words;
+    vector<lda_topic_t> topics;
+    vector<int32_t>     labels;       // doc এর label id
+
+    int    size()        const { return (int)labels.size(); }
+    size_t tokens()      const { return words.size(); }
+    int    length(int d) const { return (int)(offsets[d + 1] - offsets[d]); }
+    void   clear()             { *this = Corpus(); }
+};
+
+// Sampler যে docs এর উপর চলে — in-memory Corpus বা mmap করা on-disk shard,
+// দুটোই একই CSR layout; d হল span এর ভেতরের doc index
+struct DocSpan
+{
+    const uint64_t* offsets = nullptr;
+    const int32_t*  words   = nullptr;
+    lda_topic_t*    topics  = nullptr;
+    const int32_t*  labels  = nullptr;
+    int             docs    = 0;
+
+    int length(int d) const { return (int)(offsets[d + 1] - offsets[d]); }
+};
+
+inline DocSpan spanOf(Corpus& c)
+{
+    return {c.offsets.data(), c.words.data(), c.topics.data(), c.labels.data(), c.size()};
+}
+
+// loadShards() এর লেখা shard file গুলো — model এর copy গুলো ভাগ করে রাখে,
+// শেষ owner গেলে file গুলো মুছে যায়
+struct ShardSet
 {
-    string      label;
-    int         labelId;
-    vector<int> wordIndices;
-    vector<int> topicAssignments;
+    vector<string> files;
+    ~ShardSet() { for (const string& f : files) remove(f.c_str()); }
+};
+
+// loadData() এর একটা chunk এর parse result। Word/label id গুলো chunk
+// এর local, first-seen ক্রমে — merge এর সময় global id তে বদলায়।
+struct CorpusChunk
+{
+    Vocabulary      words;
+    vector<string>  labels;
+    Corpus          docs;     // labels, words local id তে
+    long long       lines = 0;
 };
 
 class SupervisedLDA
 {
 private:
     int K, V, D;
-    vector<Document>       docs;
-    vector<string>         vocab;
-    map<string, int>       wordToId;
+    Corpus                 corpus;
+    Vocabulary             vocab;
     map<string, int>       labelToId;
     map<int, string>       idToLabel;
-    vector<vector<int>>    nw;
-    vector<vector<int>>    nd;
+    CountMatrix<lda_count_t> nw;        // V×K
+    CountMatrix<lda_count_t> nd;        // D×K
     vector<int>            nwsum;
     vector<int>            ndsum;
-    vector<vector<double>> nw_acc;
-<<<<<<< HEAD
-=======
+    vector<double>         nw_acc;      // V×K row-major averaged counts
+    // Training চলাকালে nw_acc এ শুধু বদলের correction: cell এ δ বদল হলে
+    // তখনকার acc_count দিয়ে -δ·acc_count। শেষে acc_count·nw যোগ করলে প্রতিটা
+    // sample এর nw এর যোগফল হয় — sample নিতে V×K pass লাগে না। Serial sweep
+    // বদল গুলো dirty তে চিহ্ন দেয় (প্রথম sample এর পরে), flushDirty() এ জমা।
+    DirtyCells             dirty;
+    bool                   trackDirty = false;
     vector<double>         nwsum_acc;   // nw_acc এর column sum — predict() এ দরকার
->>>>>>> 51c03b0
     int                    acc_count = 0;
+    double                 alpha = LDA_ALPHA, beta = LDA_BETA, eta = LDA_ETA;
     mt19937                rng;
     TextPreprocessor       preprocessor;
 
+    // predict() এই pointer দিয়ে nw_acc পড়ে — train() এর পরে nw_acc.data(),
+    // mmap load এর পরে mapped file এর ভেতরে
+    const double*          accRows = nullptr;
+    shared_ptr<MappedFile> mapped;
+
+    // log φ[w][k] = log((nw_acc[w][k]+β) / (nwsum_acc[k]+Vβ)), V×K row-major।
+    // Model frozen, তাই একবার বানালেই predict() শুধু row গুলো যোগ করে।
+    // logPhi হয় logPhiTable.data() নয়তো mapped file এর ভেতরে।
+    vector<float, AlignedAllocator<float>> logPhiTable;
+    const float*           logPhi = nullptr;
+    // table এ যে log denominator বসানো (buildLogPhi এর সময়ের), আর
+    // addDocuments() এর পরে এখনকার সাথে তার পার্থক্য — matched token প্রতি
+    // একবার score এ যোগ হয়, তাই nwsum_acc বদলালে পুরো table লিখতে হয় না।
+    // খালি = table হুবহু ঠিক।
+    vector<double>         phiDen;
+    vector<double>         phiShift;
+
+    int                    numThreads = 1;
+    vector<int>            docSplit;    // thread t এর docs: [docSplit[t], docSplit[t+1])
+
+    SamplerType            sampler = SamplerType::Dense;
+    int                    mhSteps = 2;
+    WordTokenIndex         tokIndex;
+
+    // sampler এখন যে docs পড়ছে — spanOf(corpus) নয়তো চলতি shard
+    DocSpan                span;
+    // loadShards() এর on-disk token shard; null = in-memory corpus
+    shared_ptr<ShardSet>   shards;
+    // trainChains() এর chain: parent এর corpus এর offsets/words/labels পড়ে,
+    // নিজের শুধু corpus.topics আর count matrix। null = নিজের corpus
+    const Corpus*          docsFrom = nullptr;
+    long long              shardTokenCount = 0;
+
+    // topic বদলালে incrementally update হয় — প্রতি sweep এ lgamma pass লাগে না
+    double                 curLL = 0;
+    bool                   earlyStop  = true;
+    double                 convTol    = CONV_TOL;
+    int                    convWindow = CONV_WINDOW;
+    int                    minSamples = MIN_SAMPLES;
+    bool                   countsReady = false;   // initCounts() হয়ে গেছে — train() এর শুরুতে
+    bool                   verbose = true;        // false: train() কিছু print করে না (trainChains এর chain)
+
+    // প্রতি ckEvery iteration এ ckPath এ checkpoint; ckEvery = 0 হলে বন্ধ
+    string                 ckPath;
+    int                    ckEvery = 0;
+    // resume() যে loop state পড়ল — পরের train() সেখান থেকে চলে
+    struct LoopState { int iter = 0, burnEnd = 0; double ll = 0; vector<double> llHist; };
+    LoopState              resumeAt;
+    bool                   resumed = false;
+
+    // train() এর progress output — verbose না হলে সব লেখা ফেলে দেয়
+    ostream& progress() const
+    {
+        thread_local ostream discard(nullptr);   // chain গুলো একসাথে লেখে
+        return verbose ? cout : discard;
+    }
+
+    // token এর শুরুর topic: ৭০% → label topic, ৩০% → label বাদে অন্য random topic
+    int initialTopic(int label)
+    {
+        uniform_int_distribution<int> randTopic(0, K - 1);
+        uniform_real_distribution<double> coin(0.0, 1.0);
+        if (coin(rng) < 0.7) return label;
+        int r = randTopic(rng);
+        return (r == label) ? (r + 1) % K : r;
+    }
+
+    // SLDA_COUNT16 এ nw/nd এর cell 65535 ছাড়ালে চুপচাপ wrap করে। কোনো nw
+    // cell word এর মোট frequency, nd cell doc এর length ছাড়াতে পারে না
+    // (thread এর local copy আর merge এও) — তাই training এর আগে এ দুটো
+    // মেলালেই হয়। না মিললে error দিয়ে false।
+    static bool countsFit(const char* who, long long maxWordFreq, long long maxDocLen)
+    {
+        const long long cap = numeric_limits<lda_count_t>::max();
+        if (maxWordFreq <= cap && maxDocLen <= cap) return true;
+        cerr << "[ERROR] " << who << ": a word occurs " << maxWordFreq
+             << " times, longest doc " << maxDocLen << " tokens — count cells hold at most "
+             << cap << " (compile without SLDA_COUNT16)" << endl;
+        return false;
+    }
+
+    // sampler যে docs পড়ে — chain এ parent এর corpus, নইলে নিজের টা
+    const Corpus& docs() const { return docsFrom ? *docsFrom : corpus; }
+
+    // in-memory corpus এর জন্য countsFit(); 32-bit count এ আগে int ই ভরে যায়
+    bool corpusFits(const char* who) const
+    {
+        if (sizeof(lda_count_t) >= sizeof(int)) return true;
+        vector<long long> freq(vocab.size(), 0);
+        for (int32_t w : corpus.words) freq[w]++;
+        long long maxLen = 0;
+        for (int d = 0; d < corpus.size(); d++) maxLen = max<long long>(maxLen, corpus.length(d));
+        return countsFit(who, freq.empty() ? 0 : *max_element(freq.begin(), freq.end()), maxLen);
+    }
+
     void initCounts()
     {
-        D = docs.size(); V = vocab.size(); K = labelToId.size();
-        nw.assign(V, vector<int>(K, 0));
-        nd.assign(D, vector<int>(K, 0));
+        countsReady = true;
+        const Corpus& c = docs();
+        D = c.size();
+        if (!docsFrom) { V = vocab.size(); K = labelToId.size(); }
+        nw.assign(V, K, 0);
+        nd.assign(D, K, 0);
         nwsum.assign(K, 0);
         ndsum.assign(D, 0);
-        nw_acc.assign(V, vector<double>(K, 0.0));
-<<<<<<< HEAD
-        for (int d = 0; d < D; ++d) {
-            docs[d].topicAssignments.resize(docs[d].wordIndices.size());
-            for (int i = 0; i < (int)docs[d].wordIndices.size(); ++i) {
-                int t = docs[d].labelId;
-=======
+        nw_acc.assign((size_t)V * K, 0.0);
         nwsum_acc.assign(K, 0.0);
-        uniform_int_distribution<int> randTopic(0, K - 1);
-        uniform_real_distribution<double> coin(0.0, 1.0);
 
+        corpus.topics.resize(c.tokens());
         for (int d = 0; d < D; ++d) {
-            docs[d].topicAssignments.resize(docs[d].wordIndices.size());
-            for (int i = 0; i < (int)docs[d].wordIndices.size(); ++i) {
-                int t;
-                if (coin(rng) < 0.7) {
-                    // ৭০% → label topic
-                    t = docs[d].labelId;
-                } else {
-                    // ৩০% → label বাদে অন্য random topic
-                    int r = randTopic(rng);
-                    t = (r == docs[d].labelId) ? (r + 1) % K : r;
-                }
->>>>>>> 51c03b0
-                docs[d].topicAssignments[i] = t;
-                nw[docs[d].wordIndices[i]][t]++;
-                nd[d][t]++; nwsum[t]++; ndsum[d]++;
+            const int label = c.labels[d];
+            for (size_t i = c.offsets[d]; i < c.offsets[d + 1]; ++i) {
+                int t = initialTopic(label);
+                corpus.topics[i] = (lda_topic_t)t;
+                nw(c.words[i], t)++;
+                nd(d, t)++; nwsum[t]++; ndsum[d]++;
             }
         }
     }
 
+    // এক token topic s → t তে গেলে LL এর পরিবর্তন। Token টা বাদ দেওয়া
+    // counts এর উপর: lgamma(n+1+β) - lgamma(n+β) = log(n+β), তাই চারটা
+    // lgamma term একটা log এ নেমে আসে; invDen ইতিমধ্যেই cache করা।
+    double llMove(const lda_count_t* nwRow, const double* invDen, int s, int t) const
+    {
+        return log((nwRow[t] + beta) * invDen[t] / ((nwRow[s] + beta) * invDen[s]));
+    }
+
+    void buildLogPhi()
+    {
+        logPhiTable.resize((size_t)V * K);
+        phiDen.resize(K);
+        for (int k = 0; k < K; k++) phiDen[k] = log(nwsum_acc[k] + V * beta);
+        phiShift.clear();
+        for (int w = 0; w < V; w++) buildLogPhiRow(w);
+        logPhi = logPhiTable.data();
+    }
+
+    // একটা row, table এর নিজের denominator (phiDen) দিয়ে
+    void buildLogPhiRow(int w)
+    {
+        const double* acc = accRows + (size_t)w * K;
+        float* row = logPhiTable.data() + (size_t)w * K;
+        for (int k = 0; k < K; k++) row[k] = (float)(log(acc[k] + beta) - phiDen[k]);
+    }
+
     double logLikelihood()
     {
         double ll = 0;
         for (int k = 0; k < K; k++) {
-            ll += lgamma(V * LDA_BETA) - V * lgamma(LDA_BETA);
-            for (int v = 0; v < V; v++) ll += lgamma(nw[v][k] + LDA_BETA);
-            ll -= lgamma(nwsum[k] + V * LDA_BETA);
+            ll += logGamma(V * beta) - V * logGamma(beta);
+            for (int v = 0; v < V; v++) ll += logGamma(nw(v, k) + beta);
+            ll -= logGamma(nwsum[k] + V * beta);
         }
         return ll;
     }
 
-public:
-    SupervisedLDA() { random_device rd; rng.seed(rd()); }
+    // [dBegin, dEnd) docs এর প্রতিটা token একবার resample করে। nwT/nwsumT
+    // serial mode এ global counts, parallel mode এ thread এর local copy।
+    // Denominator গুলো cache করা থাকে, শুধু old/new topic এর টা বদলায়।
+    // Return: nwT/nwsumT এর উপর logLikelihood() এর পরিবর্তন।
+    double sampleDocs(int dBegin, int dEnd, CountMatrix<lda_count_t>& nwT,
+                      vector<int>& nwsumT, mt19937& g, SamplerScratch& sc)
+    {
+        double dll = 0;
+        const double Vbeta = V * beta;
+        sc.cum.resize(K);
+        sc.invDen.resize(K);
+        for (int k = 0; k < K; ++k) sc.invDen[k] = 1.0 / (nwsumT[k] + Vbeta);
+        double* cum    = sc.cum.data();
+        double* invDen = sc.invDen.data();
+        uniform_real_distribution<double> unif(0.0, 1.0);
+
+        for (int d = dBegin; d < dEnd; ++d) {
+            lda_count_t* ndRow = nd.row(d);
+            const int label = span.labels[d];
+            const int len   = span.length(d);
+            const int32_t* words  = span.words  + span.offsets[d];
+            lda_topic_t*   topics = span.topics + span.offsets[d];
+
+            for (int i = 0; i < len; ++i) {
+                int old = topics[i];
+                lda_count_t* nwRow = nwT.row(words[i]);
+                nwRow[old]--; ndRow[old]--; nwsumT[old]--;
+                invDen[old] = 1.0 / (nwsumT[old] + Vbeta);
+
+                // branch-free loop — compiler vectorize করতে পারে
+                for (int k = 0; k < K; ++k)
+                    cum[k] = (nwRow[k] + beta) * invDen[k] * (ndRow[k] + alpha);
+                cum[label] *= eta;
+                double pSum = 0;
+                for (int k = 0; k < K; ++k) { pSum += cum[k]; cum[k] = pSum; }
+
+                // প্রথম k যেখানে r < cum[k] — binary search
+                double r = unif(g) * pSum;
+                int nt = upper_bound(cum, cum + K, r) - cum;
+                if (nt >= K) nt = K - 1;
+
+                if (nt != old) {
+                    dll += llMove(nwRow, invDen, old, nt);
+                    if (trackDirty) {
+                        size_t c = (size_t)words[i] * K;
+                        dirty.mark(c + old, nwRow[old] + 1);
+                        dirty.mark(c + nt,  nwRow[nt]);
+                    }
+                }
+                topics[i] = (lda_topic_t)nt;
+                nwRow[nt]++; ndRow[nt]++; nwsumT[nt]++;
+                invDen[nt] = 1.0 / (nwsumT[nt] + Vbeta);
+            }
+        }
+        return dll;
+    }
+
+    // MH sampler এর জন্য word-ordered topic index বানায়
+    void initTokenIndex()
+    {
+        WordTokenIndex& ix = tokIndex;
+        const vector<int32_t>& words = docs().words;
+        const size_t N = words.size();
+        ix.wordOff.assign(V + 1, 0);
+        for (int32_t w : words) ix.wordOff[w + 1]++;
+        for (int w = 0; w < V; ++w) ix.wordOff[w + 1] += ix.wordOff[w];
+        ix.tokPos.resize(N);
+        vector<int> fill(ix.wordOff.begin(), ix.wordOff.end() - 1);
+        for (size_t i = 0; i < N; ++i) ix.tokPos[i] = fill[words[i]]++;
+        ix.wordTopic.resize(N);
+        syncTokenIndex();
+    }
+
+    void syncTokenIndex()
+    {
+        WordTokenIndex& ix = tokIndex;
+        for (size_t i = 0; i < corpus.topics.size(); ++i)
+            ix.wordTopic[ix.tokPos[i]] = corpus.topics[i];
+    }
+
+    // MH sampler: প্রতিটা token এ mhSteps বার (word proposal, doc proposal)
+    // cycle। Target conditional dense sampler এর মতোই। Serial mode এ proposal
+    // current counts থেকে, তাই chain exact; parallel mode এ (useSnapshot)
+    // sweep শুরুর global nw আর wordTopic থেকে — অন্য thread এর সাথে race নেই।
+    double sampleDocsMH(int dBegin, int dEnd, CountMatrix<lda_count_t>& nwT,
+                        vector<int>& nwsumT, mt19937& g, SamplerScratch& sc,
+                        bool useSnapshot)
+    {
+        double dll = 0;
+        WordTokenIndex& ix = tokIndex;
+        const double Vbeta  = V * beta;
+        const double Kalpha = K * alpha;
+        const double Kbeta  = K * beta;
+        sc.invDen.resize(K);
+        for (int k = 0; k < K; ++k) sc.invDen[k] = 1.0 / (nwsumT[k] + Vbeta);
+        double* invDen = sc.invDen.data();
+        uniform_real_distribution<double> unif(0.0, 1.0);
+
+        for (int d = dBegin; d < dEnd; ++d) {
+            lda_count_t* ndRow = nd.row(d);
+            const int label = span.labels[d];
+            const int len   = span.length(d);
+            const int32_t* words  = span.words  + span.offsets[d];
+            lda_topic_t*   topics = span.topics + span.offsets[d];
+            const int*     tokPos = ix.tokPos.data() + span.offsets[d];
+
+            for (int i = 0; i < len; ++i) {
+                const int w = words[i], s0 = topics[i];
+                int s = s0;
+                lda_count_t* nwRow = nwT.row(w);
+                nwRow[s]--; ndRow[s]--; nwsumT[s]--;
+                invDen[s] = 1.0 / (nwsumT[s] + Vbeta);
+
+                const int pos  = tokPos[i];
+                const int off  = ix.wordOff[w];
+                const int rest = ix.wordOff[w + 1] - off - 1;   // word এর অন্য token
+                // word proposal এর count: এই token বাদে word এর বাকি tokens
+                const lda_count_t* qRow = useSnapshot ? nw.row(w) : nwRow;
+                const int qSelf = useSnapshot ? ix.wordTopic[pos] : -1;
+                auto qw  = [&](int k) { return qRow[k] - (k == qSelf) + beta; };
+                auto phi = [&](int k) {
+                    double p = (nwRow[k] + beta) * invDen[k];
+                    return k == label ? p * eta : p;
+                };
+
+                for (int step = 0; step < mhSteps; ++step) {
+                    // word proposal: word এর অন্য একটা token এর topic, নয়তো uniform
+                    int t;
+                    double x = unif(g) * (rest + Kbeta);
+                    if (x < rest) {
+                        int j = off + (int)x;
+                        if (j == pos) j = off + rest;
+                        t = ix.wordTopic[j];
+                    } else {
+                        t = min((int)((x - rest) / beta), K - 1);
+                    }
+                    if (t != s) {
+                        double a = phi(t) * (ndRow[t] + alpha) * qw(s)
+                                 / (phi(s) * (ndRow[s] + alpha) * qw(t));
+                        if (a >= 1.0 || unif(g) < a) s = t;
+                    }
+
+                    // doc proposal: doc এর অন্য একটা token এর topic, নয়তো
+                    // uniform — acceptance এ nd term কেটে যায়
+                    x = unif(g) * (len - 1 + Kalpha);
+                    if (x < len - 1) {
+                        int j = (int)x;
+                        if (j >= i) j++;
+                        t = topics[j];
+                    } else {
+                        t = min((int)((x - (len - 1)) / alpha), K - 1);
+                    }
+                    if (t != s) {
+                        double a = phi(t) / phi(s);
+                        if (a >= 1.0 || unif(g) < a) s = t;
+                    }
+                }
 
-    void loadData(const string& filename)
+                if (s != s0) {
+                    dll += llMove(nwRow, invDen, s0, s);
+                    if (trackDirty) {
+                        size_t c = (size_t)w * K;
+                        dirty.mark(c + s0, nwRow[s0] + 1);
+                        dirty.mark(c + s,  nwRow[s]);
+                    }
+                }
+                topics[i] = (lda_topic_t)s;
+                if (!useSnapshot) ix.wordTopic[pos] = (lda_topic_t)s;
+                nwRow[s]++; ndRow[s]++; nwsumT[s]++;
+                invDen[s] = 1.0 / (nwsumT[s] + Vbeta);
+            }
+        }
+        return dll;
+    }
+
+    double sweepDocs(int dBegin, int dEnd, CountMatrix<lda_count_t>& nwT,
+                     vector<int>& nwsumT, mt19937& g, SamplerScratch& sc,
+                     bool parallel = false)
+    {
+        if (sampler == SamplerType::MH) return sampleDocsMH(dBegin, dEnd, nwT, nwsumT, g, sc, parallel);
+        return sampleDocs(dBegin, dEnd, nwT, nwsumT, g, sc);
+    }
+
+    // গত period এ বদলানো প্রতিটা cell এর correction nw_acc এ: period টায়
+    // acc_count টা sample আগে নেওয়া হয়ে গেছে, net বদল δ → -δ·acc_count
+    void flushDirty()
+    {
+        for (auto& [c, before] : dirty.list) {
+            nw_acc[c] -= (double)((int32_t)nw.data()[c] - before) * acc_count;
+            dirty.bits[c >> 6] = 0;
+        }
+        dirty.list.clear();
+    }
+
+    // corpus.topics থেকে nw/nd/nwsum/ndsum আবার গোনে (resume এর পরে)
+    void countTopics()
+    {
+        nw.assign(V, K, 0);
+        nd.assign(D, K, 0);
+        nwsum.assign(K, 0);
+        ndsum.assign(D, 0);
+        for (int d = 0; d < D; ++d)
+            for (size_t i = corpus.offsets[d]; i < corpus.offsets[d + 1]; ++i) {
+                int t = corpus.topics[i];
+                nw(corpus.words[i], t)++;
+                nd(d, t)++; nwsum[t]++; ndsum[d]++;
+            }
+    }
+
+    // words, labels আর doc boundary এর hash — checkpoint অন্য corpus এর
+    // (বা অন্য feature selection / vocab ক্রমের) হলে resume() ধরে ফেলে
+    uint64_t corpusFingerprint() const
+    {
+        auto bytes = [](const auto& v) {
+            return string_view((const char*)v.data(), v.size() * sizeof(v[0]));
+        };
+        uint32_t a = phHash(bytes(corpus.words));
+        uint32_t b = phMix(phHash(bytes(corpus.labels)), phHash(bytes(corpus.offsets)));
+        return (uint64_t)a << 32 | b;
+    }
+
+    // iteration শেষের পুরো sampler state checkpoint file এর bytes এ।
+    // Sampling thread এ শুধু copy — লেখা হয় writeCheckpoint() এ।
+    string checkpointBytes(int iter, int burnEnd, const vector<double>& llHist,
+                           uint64_t fingerprint) const
+    {
+        ostringstream rs;
+        rs << rng;
+        const string rngState = rs.str();
+
+        string buf;
+        buf.reserve(96 + llHist.size() * 8 + rngState.size()
+                    + corpus.topics.size() * sizeof(lda_topic_t) + (K + nw_acc.size()) * 8);
+        auto put    = [&](const void* p, size_t n) { buf.append((const char*)p, n); };
+        auto putU32 = [&](uint32_t x) { put(&x, sizeof x); };
+        auto putU64 = [&](uint64_t x) { put(&x, sizeof x); };
+        auto putF64 = [&](double x)   { put(&x, sizeof x); };
+
+        put(CKPT_MAGIC, 4);
+        putU32(CKPT_VERSION);
+        putU32(D); putU32(V); putU32(K); putU32(sizeof(lda_topic_t));
+        putU64(corpus.tokens()); putU64(fingerprint);
+        putF64(alpha); putF64(beta); putF64(eta);
+        putU32(iter); putU32(burnEnd); putU32(acc_count);
+        putF64(curLL);
+        putU32(llHist.size());
+        put(llHist.data(), llHist.size() * sizeof(double));
+        putU32(rngState.size());
+        put(rngState.data(), rngState.size());
+        put(corpus.topics.data(), corpus.topics.size() * sizeof(lda_topic_t));
+        put(nwsum_acc.data(), nwsum_acc.size() * sizeof(double));
+        put(nw_acc.data(), nw_acc.size() * sizeof(double));
+        return buf;
+    }
+
+    // tmp এ লিখে rename — crash হলে আগের checkpoint অক্ষত থাকে
+    static bool writeCheckpoint(const string& filename, const string& bytes)
+    {
+        string tmp = filename + ".tmp";
+        ofstream out(tmp, ios::binary | ios::trunc);
+        if (!out.is_open()) { cerr << "[ERROR] cannot write " << tmp << endl; return false; }
+        out.write(bytes.data(), bytes.size());
+        out.close();
+        if (!out) { cerr << "[ERROR] failed writing " << tmp << endl; remove(tmp.c_str()); return false; }
+
+        // POSIX এ rename পুরনো file কে atomically বদলায়; Windows এ
+        // target থাকলে rename fail করে, তখন আগে মুছে আবার চেষ্টা
+        if (rename(tmp.c_str(), filename.c_str()) != 0) {
+            remove(filename.c_str());
+            if (rename(tmp.c_str(), filename.c_str()) != 0) {
+                cerr << "[ERROR] cannot rename " << tmp << " to " << filename << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // শেষ দুই window এর গড় LL এর relative পার্থক্য convTol এর কম হলে true
+    bool converged(const vector<double>& llHist) const
+    {
+        int n = llHist.size(), W = convWindow;
+        if (n < 2 * W) return false;
+        double prev = 0, last = 0;
+        for (int i = n - 2 * W; i < n - W; i++) prev += llHist[i];
+        for (int i = n - W; i < n; i++)         last += llHist[i];
+        return fabs(last - prev) <= convTol * fabs(prev);
+    }
+
+    // token সংখ্যা অনুযায়ী span এর docs কে T টা প্রায় সমান ভাগে ভাগ করে
+    void splitDocs(int T)
+    {
+        const int       n     = span.docs;
+        const long long total = span.offsets[n];
+        docSplit.assign(T + 1, n);
+        docSplit[0] = 0;
+        long long seen = 0; int t = 1;
+        for (int d = 0; d < n && t < T; ++d) {
+            seen += span.length(d);
+            if (seen * T >= total * t) docSplit[t++] = d + 1;
+        }
+    }
+
+    // AD-LDA sweep: প্রতিটা thread global nw এর copy নিয়ে নিজের docs sample
+    // করে, শেষে সব thread এর delta (local - snapshot) global এ যোগ হয়।
+    // Thread এর নিজের LL delta local copy এর উপর, তাই curLL merge এর সময়
+    // শুধু বদলানো cells থেকে update হয়।
+    void parallelSweep(int T, vector<CountMatrix<lda_count_t>>& localNw,
+                       vector<vector<int>>& localNwsum, vector<SamplerScratch>& scratch)
+    {
+        sampleLocal(T, true, localNw, localNwsum, scratch);
+        mergeLocal(T, localNw, localNwsum);
+    }
+
+    // Thread t span এর docSplit[t] ভাগ localNw[t] এর উপর sample করে।
+    // fresh হলে আগে global nw এর copy নেয়; নইলে আগের copy তেই চলে
+    // (shardSweep এ sweep এর সব shard একই copy তে, merge একবার)।
+    void sampleLocal(int T, bool fresh, vector<CountMatrix<lda_count_t>>& localNw,
+                     vector<vector<int>>& localNwsum, vector<SamplerScratch>& scratch)
     {
-        ifstream file(filename);
-        if (!file.is_open()) { cerr << "[ERROR] input.txt not found!" << endl; exit(1); }
+        vector<unsigned> seeds(T);
+        for (auto& sd : seeds) sd = rng();
 
+        runThreads(T, [&](int t) {
+            if (fresh) { localNw[t] = nw; localNwsum[t] = nwsum; }
+            mt19937 g(seeds[t]);
+            sweepDocs(docSplit[t], docSplit[t + 1], localNw[t], localNwsum[t], g, scratch[t], true);
+        });
+    }
+
+    // সব thread এর delta (local - global) global nw/nwsum এ যোগ করে
+    void mergeLocal(int T, vector<CountMatrix<lda_count_t>>& localNw,
+                    vector<vector<int>>& localNwsum)
+    {
+        lda_count_t* g = nw.data();
+        for (size_t c = 0; c < nw.size(); c++) {
+            int base = g[c], sum = base;
+            for (int t = 0; t < T; t++) sum += (int)localNw[t].data()[c] - base;
+            if (sum != base) {
+                curLL += logGamma(sum + beta) - logGamma(base + beta);
+                if (acc_count > 0) nw_acc[c] -= (double)(sum - base) * acc_count;
+            }
+            g[c] = (lda_count_t)sum;
+        }
+        for (int k = 0; k < K; k++) {
+            int base = nwsum[k], c = base;
+            for (int t = 0; t < T; t++) c += localNwsum[t][k] - base;
+            if (c != base) curLL -= logGamma(c + V * beta) - logGamma(base + V * beta);
+            nwsum[k] = c;
+        }
+        if (sampler == SamplerType::MH) syncTokenIndex();
+    }
+
+    // "LABEL|text" file এর label গুলো first-seen ক্রমে labelToId/idToLabel এ
+    // ভরে, labelled line এর সংখ্যা ফেরত দেয় — O(K) memory। countWords হলে
+    // text tokenize করে শুধু word আছে এমন doc গোনে (loadData() এর মতো)।
+    // File না খুললে বা এমন line না থাকলে error দিয়ে 0।
+    long long scanLabels(const string& filename, bool countWords = false)
+    {
+        ifstream in(filename);
+        if (!in.is_open()) {
+            cerr << "[ERROR] " << filename << " not found!" << endl;
+            return 0;
+        }
+        labelToId.clear(); idToLabel.clear();
+        long long docs = 0;
         string line;
-        while (getline(file, line)) {
+        TokenBuffer tokens;
+        while (getline(in, line)) {
             size_t pos = line.find('|');
             if (pos == string::npos) continue;
-            string labelStr = line.substr(0, pos);
-            string text     = line.substr(pos + 1);
+            if (countWords) {
+                preprocessor.tokenize(string_view(line).substr(pos + 1), tokens);
+                if (tokens.empty()) continue;
+            }
+            docs++;
+            auto [it, added] = labelToId.emplace(line.substr(0, pos), (int)labelToId.size());
+            if (added) idToLabel[it->second] = it->first;
+        }
+        if (docs == 0)
+            cerr << "[ERROR] no " << (countWords ? "documents with words" : "labelled documents")
+                 << " in " << filename << endl;
+        return docs;
+    }
+
+    // একটা shard এর docs (offsets 0 থেকে) file এ লেখে
+    static bool writeShard(const string& filename, const Corpus& c)
+    {
+        ofstream out(filename, ios::binary | ios::trunc);
+        if (!out.is_open()) { cerr << "[ERROR] cannot write " << filename << endl; return false; }
+        auto putU32 = [&](uint32_t x) { out.write((const char*)&x, sizeof x); };
+        auto putU64 = [&](uint64_t x) { out.write((const char*)&x, sizeof x); };
+        out.write(SHARD_MAGIC, 4);
+        putU32(SHARD_VERSION);
+        putU32(c.size()); putU32(sizeof(lda_topic_t));
+        putU64(c.tokens()); putU64(0);
+        out.write((const char*)c.offsets.data(), sizeof(uint64_t) * c.offsets.size());
+        out.write((const char*)c.labels.data(),  sizeof(int32_t) * c.labels.size());
+        out.write((const char*)c.words.data(),   sizeof(int32_t) * c.words.size());
+        out.write((const char*)c.topics.data(),  sizeof(lda_topic_t) * c.topics.size());
+        out.close();
+        if (!out) { cerr << "[ERROR] failed writing " << filename << endl; return false; }
+        return true;
+    }
+
+    // Writable mmap করা shard থেকে DocSpan — topics সরাসরি file এ লেখা হয়
+    static bool shardSpan(MappedFile& f, DocSpan& out)
+    {
+        const size_t HEADER = 32;
+        char* p = f.data();
+        if (f.size() < HEADER || memcmp(p, SHARD_MAGIC, 4) != 0) return false;
+        uint32_t version, docs, topicBytes;
+        uint64_t tokens;
+        memcpy(&version, p + 4, 4); memcpy(&docs, p + 8, 4);
+        memcpy(&topicBytes, p + 12, 4); memcpy(&tokens, p + 16, 8);
+        if (version != SHARD_VERSION || topicBytes != sizeof(lda_topic_t)) return false;
+        size_t need = HEADER + 8 * ((size_t)docs + 1) + 4 * (size_t)docs
+                    + (4 + sizeof(lda_topic_t)) * tokens;
+        if (f.size() != need) return false;
+
+        out.offsets = (const uint64_t*)(p + HEADER);
+        out.labels  = (const int32_t*)(out.offsets + docs + 1);
+        out.words   = out.labels + docs;
+        out.topics  = (lda_topic_t*)(p + need - sizeof(lda_topic_t) * tokens);
+        out.docs    = docs;
+        return out.offsets[docs] == tokens;
+    }
+
+    // Out-of-core sweep: shard গুলো ক্রমে map করে sample করে। পরের shard
+    // background thread এ map আর prefetch হয় — disk read চলতি shard এর
+    // sampling এর সাথে overlap করে। Memory তে থাকে nw, nwsum আর চলতি
+    // shard এর nd; বাকি সব page cache এর, kernel দরকারে ফেলে দেয়।
+    // T > 1 এ thread এর local nw পুরো sweep জুড়ে থাকে, merge sweep এর
+    // শেষে একবার — shard প্রতি V×K copy/merge নয়। কোনো shard পড়া না
+    // গেলে error দিয়ে false (তার token nw তে আটকে থাকত)।
+    bool shardSweep(int T, vector<CountMatrix<lda_count_t>>& localNw,
+                    vector<vector<int>>& localNwsum, vector<SamplerScratch>& scratch)
+    {
+        MappedFile buf[2];
+        const vector<string>& files = shards->files;
+        const size_t n = files.size();
+        auto mapShard = [&](size_t s) {
+            if (buf[s & 1].open(files[s], true)) buf[s & 1].prefetch();
+        };
+        mapShard(0);
+        bool ok = true;
+        for (size_t s = 0; s < n && ok; s++) {
+            thread ahead;
+            if (s + 1 < n) ahead = thread(mapShard, s + 1);
+
+            if (!shardSpan(buf[s & 1], span)) {
+                cerr << "[ERROR] cannot read shard " << files[s] << endl;
+                ok = false;
+            } else {
+                // shard এর nd topics থেকেই গোনা — আলাদা করে রাখতে হয় না
+                nd.assign(span.docs, K, 0);
+                for (int d = 0; d < span.docs; d++)
+                    for (uint64_t i = span.offsets[d]; i < span.offsets[d + 1]; i++)
+                        nd(d, span.topics[i])++;
+                if (T > 1) {
+                    splitDocs(T);
+                    sampleLocal(T, s == 0, localNw, localNwsum, scratch);
+                } else {
+                    curLL += sweepDocs(0, span.docs, nw, nwsum, rng, scratch[0]);
+                }
+            }
+            if (ahead.joinable()) ahead.join();
+            buf[s & 1].close();   // লেখা topics page cache হয়ে file এ যায়
+        }
+        span = DocSpan();
+        if (ok && T > 1) mergeLocal(T, localNw, localNwsum);
+        return ok;
+    }
+
+    // [p, p+n) এর প্রতিটা "LABEL|text" line tokenize করে out এ রাখে।
+    // '|' ছাড়া line বাদ; token না থাকা line এর label তবুও register হয়।
+    void parseChunk(const char* p, size_t n, CorpusChunk& out) const
+    {
+        TokenBuffer tokens;   // সব line এ একই buffer
+        unordered_map<string_view, int> labelIds;
+        const char* end = p + n;
+        while (p < end) {
+            const char* nl = (const char*)memchr(p, '\n', end - p);
+            string_view line(p, (nl ? nl : end) - p);
+            p = nl ? nl + 1 : end;
+            out.lines++;
+
+            size_t pos = line.find('|');
+            if (pos == string_view::npos) continue;
+            string_view label = line.substr(0, pos);
 
-            if (!labelToId.count(labelStr)) {
-                int id = labelToId.size();
-                labelToId[labelStr] = id;
-                idToLabel[id] = labelStr;
+            auto lit = labelIds.find(label);
+            if (lit == labelIds.end()) {
+                lit = labelIds.emplace(label, (int)out.labels.size()).first;
+                out.labels.emplace_back(label);
             }
 
-            Document doc;
-            doc.label   = labelStr;
-            doc.labelId = labelToId[labelStr];
+            preprocessor.tokenize(line.substr(pos + 1), tokens);
+            if (tokens.empty()) continue;
+            for (size_t i = 0; i < tokens.size(); i++)
+                out.docs.words.push_back(out.words.intern(tokens[i]));
+            out.docs.offsets.push_back(out.docs.words.size());
+            out.docs.labels.push_back(lit->second);
+        }
+    }
+
+public:
+    SupervisedLDA() { random_device rd; rng.seed(rd()); }
+
+    // Reproducible training এর জন্য; না দিলে random_device থেকে
+    void setSeed(uint32_t seed) { rng.seed(seed); }
+
+    // Gibbs sampling এর thread সংখ্যা; 1 = serial sampler, 0 = সব core
+    void setThreads(int n) { numThreads = resolveThreads(n); }
+
+    // Runtime এ sampler বাছাই; বড় K (শত শত label) এর জন্য MH
+    void setSampler(SamplerType type, int steps = 2)
+    {
+        sampler = type;
+        mhSteps = max(1, steps);
+    }
+
+    // on = false হলে পুরনো fixed schedule (BURN_IN, THINNING, LDA_ITER)।
+    // on = true হলে LL converge করলেই burn-in শেষ, আর minSamples টা
+    // sample জমার পরেও chain stable থাকলে training শেষ।
+    void setEarlyStopping(bool on, double tol = CONV_TOL,
+                          int window = CONV_WINDOW, int samples = MIN_SAMPLES)
+    {
+        earlyStop  = on;
+        convTol    = tol;
+        convWindow = max(2, window);
+        minSamples = max(1, samples);
+    }
+
+    // train() প্রতি every iteration এ পুরো sampler state filename এ লেখে।
+    // State copy sampling thread এ, file লেখা background thread এ — পরের
+    // checkpoint এর আগে লেখা শেষ না হলেই শুধু অপেক্ষা। Training শেষ হলে
+    // file টা মুছে যায়। every = 0 হলে বন্ধ।
+    void setCheckpoint(const string& filename, int every = 50)
+    {
+        ckPath  = filename;
+        ckEvery = filename.empty() ? 0 : max(0, every);
+    }
+
+    // loadData() (আর একই sortVocabByFrequency / selectFeatures) এর পরে,
+    // train() এর আগে call। Checkpoint এর state load করে — পরের train()
+    // সেই iteration থেকে চলে, আর না থামা run এর সাথে হুবহু একই result দেয়
+    // (একই thread সংখ্যা আর sampler হলে)। File না থাকলে চুপচাপ false;
+    // অন্য corpus এর বা ভাঙা হলে error দিয়ে false — তখন train() নতুন করে শুরু।
+    bool resume(const string& filename)
+    {
+        if (corpus.size() == 0) {
+            cerr << "[ERROR] resume(): call after loadData()" << endl;
+            return false;
+        }
+        MappedFile file;
+        if (!file.open(filename)) return false;
+
+        const char* p   = file.data();
+        const char* end = p + file.size();
+        bool ok = true;
+        auto need   = [&](size_t n) { if ((size_t)(end - p) < n) ok = false; return ok; };
+        auto get    = [&](void* dst, size_t n) { if (need(n)) { memcpy(dst, p, n); p += n; } };
+        auto getU32 = [&]() { uint32_t x = 0; get(&x, 4); return x; };
+        auto getU64 = [&]() { uint64_t x = 0; get(&x, 8); return x; };
+        auto getF64 = [&]() { double x = 0; get(&x, 8); return x; };
+
+        if (!need(4) || memcmp(p, CKPT_MAGIC, 4) != 0) {
+            cerr << "[ERROR] " << filename << " is not a checkpoint file" << endl;
+            return false;
+        }
+        p += 4;
+        if (getU32() != CKPT_VERSION) {
+            cerr << "[ERROR] " << filename << ": unsupported checkpoint version" << endl;
+            return false;
+        }
+        uint32_t d = getU32(), v = getU32(), k = getU32(), topicBytes = getU32();
+        uint64_t tokens = getU64(), fingerprint = getU64();
+        if (!ok || d != (uint32_t)corpus.size() || v != (uint32_t)vocab.size()
+            || k != labelToId.size() || topicBytes != sizeof(lda_topic_t)
+            || tokens != corpus.tokens() || fingerprint != corpusFingerprint()) {
+            cerr << "[ERROR] " << filename << " was written for a different corpus" << endl;
+            return false;
+        }
+        double a = getF64(), b = getF64(), e = getF64();
+        LoopState st;
+        st.iter    = getU32();
+        st.burnEnd = getU32();
+        int samples = getU32();
+        st.ll = getF64();
+        st.llHist.resize(min<size_t>(getU32(), LDA_ITER + 1));
+        get(st.llHist.data(), st.llHist.size() * sizeof(double));
+        string rngState(min<size_t>(getU32(), end - p), '\0');
+        get(&rngState[0], rngState.size());
+
+        D = d; V = v; K = k;
+        const size_t cells = (size_t)V * K;
+        if (!ok || !need(tokens * topicBytes + (K + cells) * sizeof(double))) {
+            cerr << "[ERROR] " << filename << " is truncated" << endl;
+            return false;
+        }
+        mt19937 g;
+        istringstream rs(rngState);
+        rs >> g;
+        // rngState এর length যেকোনো, তাই বাকিটা aligned না — memcpy দিয়ে পড়ি
+        vector<lda_topic_t> topics(tokens);
+        get(topics.data(), tokens * topicBytes);
+        bool valid = !rs.fail() && (int)st.llHist.size() == st.iter && st.iter <= LDA_ITER;
+        for (size_t i = 0; i < tokens && valid; i++) valid = (uint32_t)topics[i] < (uint32_t)K;
+        if (!valid) {
+            cerr << "[ERROR] " << filename << " is corrupt" << endl;
+            return false;
+        }
+
+        corpus.topics = move(topics);
+        nwsum_acc.resize(K);
+        get(nwsum_acc.data(), K * sizeof(double));
+        nw_acc.resize(cells);
+        get(nw_acc.data(), cells * sizeof(double));
+        acc_count = samples;
+        alpha = a; beta = b; eta = e;
+        rng = g;
+        countTopics();
+        countsReady = true;
+        resumeAt = move(st);
+        resumed  = true;
+        cout << "[Topic Model] Resuming from " << filename << " at iteration "
+             << resumeAt.iter << " | Samples: " << acc_count << endl;
+        return true;
+    }
+
+    // "LABEL|text" line এর file mmap করে জায়গাতেই string_view দিয়ে parse
+    // করে। threads > 1 হলে (0 = সব core) file টা line boundary তে chunk এ
+    // ভাগ হয়ে আলাদা thread এ tokenize হয়; merge chunk ক্রমে, তাই word
+    // আর label id thread সংখ্যা যাই হোক serial load এর সমান।
+    // File না খুললে বা কোনো labelled document না থাকলে false।
+    bool loadData(const string& filename, int threads = 0)
+    {
+        MappedFile file;
+        if (!file.open(filename)) {
+            cerr << "[ERROR] " << filename << " not found!" << endl;
+            return false;
+        }
+        const char* base = file.data();
+        size_t      n    = file.size();
 
-            vector<string> tokens = preprocessor.tokenize(text);
-            for (const string& tok : tokens) {
-                if (!wordToId.count(tok)) {
-                    wordToId[tok] = vocab.size();
-                    vocab.push_back(tok);
+        // প্রতিটা thread কমপক্ষে ~1MB পায়; cut গুলো পরের '\n' এর পরে সরে যায়
+        const size_t MIN_CHUNK = 1 << 20;
+        int T = (int)min<size_t>(resolveThreads(threads), max<size_t>(1, n / MIN_CHUNK));
+        vector<size_t> cut(T + 1, n);
+        cut[0] = 0;
+        for (int c = 1; c < T; c++) {
+            size_t p = max(cut[c - 1], n / T * c);
+            const char* nl = p < n ? (const char*)memchr(base + p, '\n', n - p) : nullptr;
+            cut[c] = nl ? (size_t)(nl - base) + 1 : n;
+        }
+
+        vector<CorpusChunk> chunks(T);
+        runThreads(T, [&](int c) { parseChunk(base + cut[c], cut[c + 1] - cut[c], chunks[c]); });
+
+        // Chunk ক্রমে local → global id; প্রতিটা chunk এর local id first-seen
+        // ক্রমে, তাই global id ও serial first-seen ক্রমেই দাঁড়ায়
+        long long lines = 0;
+        for (CorpusChunk& ch : chunks) {
+            vector<int> labelMap(ch.labels.size()), wordMap(ch.words.size());
+            for (size_t l = 0; l < ch.labels.size(); l++) {
+                auto it = labelToId.find(ch.labels[l]);
+                if (it == labelToId.end()) {
+                    int id = labelToId.size();
+                    it = labelToId.emplace(ch.labels[l], id).first;
+                    idToLabel[id] = ch.labels[l];
                 }
-                doc.wordIndices.push_back(wordToId[tok]);
+                labelMap[l] = it->second;
             }
-            if (!doc.wordIndices.empty()) docs.push_back(doc);
+            for (int w = 0; w < ch.words.size(); w++) wordMap[w] = vocab.intern(ch.words[w]);
+            const uint64_t base = corpus.tokens();
+            for (int32_t l : ch.docs.labels)               corpus.labels.push_back(labelMap[l]);
+            for (int32_t w : ch.docs.words)                corpus.words.push_back(wordMap[w]);
+            for (size_t d = 1; d < ch.docs.offsets.size(); d++) corpus.offsets.push_back(base + ch.docs.offsets[d]);
+            lines += ch.lines;
+            ch = CorpusChunk();   // merge হওয়া chunk এর memory ছেড়ে দিই
+        }
+        if (corpus.size() == 0) {
+            cerr << "[ERROR] no labelled documents in " << filename << endl;
+            return false;
         }
-        initCounts();
+        if ((int)labelToId.size() > MAX_TOPICS) {
+            cerr << "[ERROR] " << labelToId.size() << " labels, max " << MAX_TOPICS
+                 << " — compile with SLDA_TOPIC32" << endl;
+            return false;
+        }
+
+        // Count matrix গুলো train() এর শুরুতে — তার আগে selectFeatures() V কমাতে পারে
+        countsReady = false;
+        shards.reset();
+        D = corpus.size(); V = vocab.size(); K = labelToId.size();
         cout << "[Topic Model] Loaded " << D << " docs | "
-             << K << " topics | " << V << " vocab words" << endl;
+             << K << " topics | " << V << " vocab words"
+             << " | " << lines << " lines, " << T << " thread(s)" << endl;
+        return true;
+    }
+
+    // RAM এ না আঁটা corpus এর জন্য loadData() এর বিকল্প: file টা line ধরে
+    // পড়ে token গুলো prefix_0000.shard, prefix_0001.shard ... এ লেখে (shard
+    // প্রতি ~shardTokens token), শুরুর topic সহ। Memory তে থাকে শুধু vocab,
+    // nw আর একটা shard এর buffer। এর পরে train() প্রতি sweep এ shard গুলো
+    // mmap করে ক্রমে পড়ে, topics জায়গাতেই file এ লেখে। Docs loadData() এর
+    // ক্রমেই, তাই একই seed এ serial result in-memory training এর সমান।
+    // Shard file গুলো model এর: পরের loadShards()/loadData()/load()/
+    // trainStreaming() এ বা model (আর তার সব copy) destroy হলে মুছে যায়।
+    // sortVocabByFrequency/selectFeatures/addDocuments/checkpoint চলে না।
+    bool loadShards(const string& filename, const string& prefix, size_t shardTokens = SHARD_TOKENS)
+    {
+        if (scanLabels(filename) == 0) return false;
+        if ((int)labelToId.size() > MAX_TOPICS) {
+            cerr << "[ERROR] " << labelToId.size() << " labels, max " << MAX_TOPICS
+                 << " — compile with SLDA_TOPIC32" << endl;
+            return false;
+        }
+        ifstream in(filename);
+        K = labelToId.size(); D = 0; V = 0;
+        vocab.clear(); corpus.clear();
+        shards.reset();                      // পুরনো shard আগে মুছি — একই prefix হলে নতুন গুলো থাকে
+        // সফল হলে তবেই shards এ; মাঝপথে false হলে লেখা file গুলো এখানেই মুছে যায়
+        auto written = make_shared<ShardSet>();
+        nw.assign(0, K); nwsum.assign(K, 0); nd.clear(); ndsum.clear();
+        nw_acc.clear(); nwsum_acc.clear(); acc_count = 0;
+        tokIndex.clear(); mapped.reset();
+        resumed = false;
+        shardTokenCount = 0;
+        shardTokens = max<size_t>(1, shardTokens);
+
+        Corpus buf;
+        auto flush = [&]() {
+            char name[16];
+            snprintf(name, sizeof name, "_%04d.shard", (int)written->files.size());
+            string path = prefix + name;
+            written->files.push_back(path);
+            if (!writeShard(path, buf)) return false;
+            shardTokenCount += buf.tokens();
+            D += buf.size();
+            buf.clear();
+            return true;
+        };
+
+        string line;
+        TokenBuffer tokens;
+        long long unknown = 0;
+        vector<long long> wordFreq;          // countsFit() এর জন্য
+        long long maxLen = 0;
+        while (getline(in, line)) {
+            size_t pos = line.find('|');
+            if (pos == string::npos) continue;
+            preprocessor.tokenize(string_view(line).substr(pos + 1), tokens);
+            if (tokens.empty()) continue;
+            // দুই pass এর মাঝে file বদলালে নতুন label আসতে পারে
+            auto it = labelToId.find(line.substr(0, pos));
+            if (it == labelToId.end()) { unknown++; continue; }
+            const int label = it->second;
+            maxLen = max<long long>(maxLen, tokens.size());
+            for (size_t i = 0; i < tokens.size(); i++) {
+                int w = vocab.intern(tokens[i]);
+                if (w == nw.rows()) { nw.growRows(w + 1); wordFreq.push_back(0); }
+                wordFreq[w]++;
+                int t = initialTopic(label);
+                buf.words.push_back(w);
+                buf.topics.push_back((lda_topic_t)t);
+                nw(w, t)++; nwsum[t]++;
+            }
+            buf.offsets.push_back(buf.words.size());
+            buf.labels.push_back(label);
+            if (buf.tokens() >= shardTokens && !flush()) return false;
+        }
+        if (buf.size() > 0 && !flush()) return false;
+        if (unknown > 0)
+            cerr << "[Warning] loadShards(): skipped " << unknown
+                 << " lines with an unknown label" << endl;
+        if (D == 0) {
+            cerr << "[ERROR] no documents with words in " << filename << endl;
+            return false;
+        }
+        if (!countsFit("loadShards()", *max_element(wordFreq.begin(), wordFreq.end()), maxLen))
+            return false;
+        shards = move(written);
+
+        V = vocab.size();
+        nw_acc.assign((size_t)V * K, 0.0);
+        nwsum_acc.assign(K, 0.0);
+        countsReady = true;
+        cout << "[Topic Model] Sharded " << D << " docs | " << K << " topics | "
+             << V << " vocab words | " << shardTokenCount << " tokens in "
+             << shards->files.size() << " shard(s)" << endl;
+        return true;
+    }
+
+    // Word id গুলো corpus frequency এর উল্টো ক্রমে নতুন করে দেয় (সমান
+    // হলে পুরনো id ক্রমে)। বেশি ব্যবহৃত nw row গুলো পাশাপাশি আসে, sweep এ
+    // cold cache line কম ছোঁয়। loadData() এর পরে, train() এর আগে; chain
+    // একই থাকে, শুধু row এর ক্রম বদলায়।
+    bool sortVocabByFrequency()
+    {
+        if (corpus.size() == 0 || countsReady || acc_count > 0) {
+            cerr << "[ERROR] sortVocabByFrequency(): call after loadData(), before train()" << endl;
+            return false;
+        }
+        vector<int> freq(V, 0);
+        for (int32_t w : corpus.words) freq[w]++;
+        vector<int> order(V);
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+
+        vector<int32_t> newId(V);
+        Vocabulary sorted;
+        sorted.reserve(V);
+        for (int i = 0; i < V; i++) {
+            newId[order[i]] = i;
+            sorted.intern(vocab[order[i]]);
+        }
+        for (int32_t& w : corpus.words) w = newId[w];
+        vocab = move(sorted);
+        return true;
+    }
+
+    // Training এর আগে vocab ছাঁটাই: document frequency এর সীমা, label প্রতি
+    // TF-IDF top-N, তারপর সর্বোচ্চ vocab size। বাদ পড়া word এর token corpus
+    // থেকে সরে যায়, খালি হয়ে যাওয়া document ও। বাকি word গুলোর আপেক্ষিক
+    // id ক্রম একই থাকে। loadData() এর পরে, train() এর আগে।
+    bool selectFeatures(const FeatureSelection& fs)
+    {
+        if (corpus.size() == 0 || countsReady || acc_count > 0) {
+            cerr << "[ERROR] selectFeatures(): call after loadData(), before train()" << endl;
+            return false;
+        }
+        const int    D0 = D, V0 = V;
+        const size_t N0 = corpus.tokens();
+
+        vector<int>       df(V, 0), lastDoc(V, -1);
+        vector<long long> freq(V, 0);
+        CountMatrix<int32_t> labelTf;   // word × label token count, শুধু TF-IDF এর জন্য
+        if (fs.topPerLabel > 0) labelTf.assign(V, K, 0);
+        for (int d = 0; d < D; d++)
+            for (size_t i = corpus.offsets[d]; i < corpus.offsets[d + 1]; i++) {
+                int w = corpus.words[i];
+                freq[w]++;
+                if (lastDoc[w] != d) { lastDoc[w] = d; df[w]++; }
+                if (fs.topPerLabel > 0) labelTf(w, corpus.labels[d])++;
+            }
+
+        vector<char> keep(V);
+        for (int w = 0; w < V; w++)
+            keep[w] = df[w] >= fs.minDocFreq && df[w] <= fs.maxDocRatio * D;
+
+        if (fs.topPerLabel > 0) {
+            // label k এ word w এর TF-IDF: label কে একটা বড় document ধরে
+            vector<long long> labelTokens(K, 0);
+            vector<int>       labelsWithTerm(V, 0);
+            for (int w = 0; w < V; w++)
+                for (int k = 0; k < K; k++)
+                    if (labelTf(w, k) > 0) { labelTokens[k] += labelTf(w, k); labelsWithTerm[w]++; }
+
+            vector<char> chosen(V, 0);
+            vector<pair<double, int>> cand;
+            for (int k = 0; k < K; k++) {
+                cand.clear();
+                for (int w = 0; w < V; w++)
+                    if (keep[w] && labelTf(w, k) > 0)
+                        cand.push_back({-TFIDFVectorizer::tfidf(labelTf(w, k), labelTokens[k],
+                                                                K, labelsWithTerm[w]), w});
+                size_t n = min<size_t>(fs.topPerLabel, cand.size());
+                partial_sort(cand.begin(), cand.begin() + n, cand.end());
+                for (size_t i = 0; i < n; i++) chosen[cand[i].second] = 1;
+            }
+            keep = move(chosen);
+        }
+
+        int kept = count(keep.begin(), keep.end(), 1);
+        if (fs.maxVocab > 0 && kept > fs.maxVocab) {
+            vector<int> ids;
+            for (int w = 0; w < V; w++) if (keep[w]) ids.push_back(w);
+            stable_sort(ids.begin(), ids.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+            for (size_t i = fs.maxVocab; i < ids.size(); i++) keep[ids[i]] = 0;
+            kept = fs.maxVocab;
+        }
+        if (kept == 0) {
+            cerr << "[ERROR] selectFeatures(): no word left" << endl;
+            return false;
+        }
+
+        // বাকি word গুলো পুরনো ক্রমে নতুন id পায়; corpus জায়গাতেই compact হয়
+        vector<int32_t> newId(V, -1);
+        Vocabulary pruned;
+        pruned.reserve(kept);
+        for (int w = 0; w < V; w++) if (keep[w]) newId[w] = pruned.intern(vocab[w]);
+
+        // offsets[d] ততক্ষণে overwrite হয়ে থাকতে পারে, তাই পুরনো begin আলাদা রাখি
+        size_t   out = 0;
+        int      docOut = 0;
+        uint64_t begin = 0;
+        for (int d = 0; d < D; d++) {
+            const uint64_t end = corpus.offsets[d + 1];
+            const size_t start = out;
+            for (uint64_t i = begin; i < end; i++)
+                if (newId[corpus.words[i]] >= 0) corpus.words[out++] = newId[corpus.words[i]];
+            begin = end;
+            if (out == start) continue;
+            corpus.labels[docOut]    = corpus.labels[d];
+            corpus.offsets[++docOut] = out;
+        }
+        corpus.words.resize(out);
+        corpus.labels.resize(docOut);
+        corpus.offsets.resize(docOut + 1);
+        vocab = move(pruned);
+        D = docOut; V = vocab.size();
+
+        // train এ V×K cell প্রতি nw + nw_acc + logPhi
+        const double cellBytes = sizeof(lda_count_t) + sizeof(double) + sizeof(float);
+        cout << fixed << setprecision(1)
+             << "[Topic Model] Feature selection: vocab " << V0 << " → " << V
+             << " | tokens " << N0 << " → " << out
+             << " | docs " << D0 << " → " << D << endl
+             << "[Topic Model] Saved ~" << (V0 - V) * (double)K * cellBytes / 1e6
+             << " MB model memory, " << 100.0 * (N0 - out) / N0
+             << "% sweep work, " << 100.0 * (V0 - V) / V0 << "% LL/accumulation work"
+             << defaultfloat << endl;
+        return true;
     }
 
-    void train()
+    // Corpus না থাকলে (load() বা trainStreaming() এর model) error দিয়ে false
+    bool train()
     {
+        if (docs().size() == 0 && !shards) {
+            cerr << "[ERROR] train(): no corpus — call loadData() or loadShards() first" << endl;
+            return false;
+        }
+        if (!countsReady) {
+            // chain এর corpus trainChains() এই দেখে নিয়েছে
+            if (!shards && !docsFrom && !corpusFits("train()")) return false;
+            initCounts();
+        }
+        // আগের train()/addDocuments() এর nw_acc এ average আছে, correction
+        // form এ নয় — নতুন run নতুন করে sample জমায়। resume() এর জমানো
+        // state ই শুধু রাখা হয়।
+        if (!resumed) {
+            acc_count = 0;
+            nw_acc.assign(nw.size(), 0.0);
+            nwsum_acc.assign(K, 0.0);
+        }
+        int T = min(numThreads, max(1, D));
+        const bool sharded = (bool)shards;
+        long long totalTokens = sharded ? shardTokenCount : (long long)docs().tokens();
+
+        vector<CountMatrix<lda_count_t>> localNw;
+        vector<vector<int>>              localNwsum;
+        vector<SamplerScratch>           scratch(T);
+        if (T > 1) {
+            localNw.resize(T); localNwsum.resize(T);
+        }
+        if (sharded) {
+            // MH এর word index আর checkpoint দুটোই পুরো corpus এর topics চায়
+            if (sampler == SamplerType::MH) {
+                progress() << "[Topic Model] MH sampler needs the corpus in memory — using Dense" << endl;
+                sampler = SamplerType::Dense;
+            }
+            if (ckEvery > 0)
+                progress() << "[Topic Model] Checkpoints are off for sharded training" << endl;
+        } else {
+            // chain এ topics নিজের, বাকি CSR parent এর
+            const Corpus& c = docs();
+            span = {c.offsets.data(), c.words.data(), corpus.topics.data(), c.labels.data(), c.size()};
+            if (T > 1) splitDocs(T);
+            if (sampler == SamplerType::MH) initTokenIndex();
+        }
+        const bool checkpoint = ckEvery > 0 && !sharded;
+
         auto t0 = chrono::steady_clock::now();
-        cout << "[Topic Model] Gibbs Sampling — Burn-in: " << BURN_IN
+        progress() << "[Topic Model] Gibbs Sampling — Burn-in: " << BURN_IN
              << " | Thinning: " << THINNING
-             << " | Iterations: " << LDA_ITER << endl;
-
-        for (int iter = 1; iter <= LDA_ITER; ++iter) {
-            for (int d = 0; d < D; ++d) {
-                for (int i = 0; i < (int)docs[d].wordIndices.size(); ++i) {
-                    int wId = docs[d].wordIndices[i];
-                    int old = docs[d].topicAssignments[i];
-                    nw[wId][old]--; nd[d][old]--; nwsum[old]--;
-
-                    vector<double> p(K); double pSum = 0;
-                    for (int k = 0; k < K; ++k) {
-                        double prob = (nw[wId][k] + LDA_BETA) / (nwsum[k] + V * LDA_BETA)
-                                    * (nd[d][k] + LDA_ALPHA);
-                        if (k == docs[d].labelId) prob *= LDA_ETA;
-                        p[k] = prob; pSum += prob;
-                    }
+             << " | Iterations: " << LDA_ITER
+             << " | Threads: " << T
+             << " | Sampler: " << (sampler == SamplerType::MH ? "MH" : "Dense")
+             << " | Early stop: " << (earlyStop ? "on" : "off") << endl;
 
-                    uniform_real_distribution<double> u(0, pSum);
-                    double r = u(rng); double cur = 0; int nt = K-1;
-                    for (int k = 0; k < K; ++k) { cur += p[k]; if (r < cur) { nt=k; break; } }
+        // burnEnd: যে iteration এ burn-in শেষ হল; early stop এ convergence এ
+        vector<double> llHist;
+        int burnEnd = earlyStop ? 0 : BURN_IN;
+        int iter = 0;
+        if (resumed) {
+            // checkpoint এর curLL ই নিই — নতুন করে গুনলে drift আলাদা হত,
+            // convergence এর সিদ্ধান্ত না থামা run থেকে সরে যেত
+            curLL   = resumeAt.ll;
+            llHist  = move(resumeAt.llHist);
+            burnEnd = resumeAt.burnEnd;
+            iter    = resumeAt.iter;
+            resumed = false;
+        } else {
+            curLL = logLikelihood();
+        }
+        llHist.reserve(LDA_ITER);
+        dirty.reset(T == 1 ? nw.size() : 0);
+        thread ckWriter;
+        const uint64_t fingerprint = checkpoint ? corpusFingerprint() : 0;
+        while (iter < LDA_ITER) {
+            ++iter;
+            trackDirty = T == 1 && acc_count > 0;
+            bool swept = true;
+            if (sharded)    swept = shardSweep(T, localNw, localNwsum, scratch);
+            else if (T > 1) parallelSweep(T, localNw, localNwsum, scratch);
+            else            curLL += sweepDocs(0, D, nw, nwsum, rng, scratch[0]);
+            if (!swept) {
+                // nw আর shard এর topics আর মেলে না — model বাতিল, shard আবার লাগবে
+                cerr << "[ERROR] train(): aborted at iteration " << iter
+                     << " — call loadShards() again" << endl;
+                if (ckWriter.joinable()) ckWriter.join();
+                shards.reset();
+                countsReady = false;
+                acc_count = 0;
+                return false;
+            }
+            llHist.push_back(curLL);
 
-                    docs[d].topicAssignments[i] = nt;
-                    nw[wId][nt]++; nd[d][nt]++; nwsum[nt]++;
-                }
+            bool mixed = earlyStop && converged(llHist);
+            if (earlyStop && burnEnd == 0 && (mixed || iter >= BURN_IN)) {
+                burnEnd = iter;
+                if (mixed)
+                    progress() << "  Iter " << setw(4) << iter << " | LL converged — burn-in ends" << endl;
             }
 
-            if (iter > BURN_IN && iter % THINNING == 0) {
-                for (int v = 0; v < V; v++)
-                    for (int k = 0; k < K; k++)
-                        nw_acc[v][k] += nw[v][k];
-<<<<<<< HEAD
-=======
+            if (burnEnd > 0 && iter > burnEnd && (iter - burnEnd) % THINNING == 0) {
+                // nw এর sample lazy — শুধু আগের period এ বদলানো cell এ হাত পড়ে
+                flushDirty();
                 // nwsum ও জমা করি — predict() এ normalized probability এর জন্য
                 for (int k = 0; k < K; k++)
                     nwsum_acc[k] += nwsum[k];
->>>>>>> 51c03b0
                 acc_count++;
             }
 
-            if (iter % 200 == 0) {
+            if (iter % 50 == 0) {
+                // মাঝে মাঝে exact মানে ফিরে যাই যাতে floating drift না জমে
+                if (iter % 200 == 0) curLL = llHist.back() = logLikelihood();
                 auto elapsed = chrono::duration_cast<chrono::seconds>(
                     chrono::steady_clock::now() - t0).count();
-                cout << "  Iter " << setw(4) << iter
-                     << " | LL: " << fixed << setprecision(1) << logLikelihood()
+                progress() << "  Iter " << setw(4) << iter
+                     << " | LL: " << fixed << setprecision(1) << curLL
                      << " | " << elapsed << "s" << endl;
             }
+
+            if (earlyStop && acc_count >= minSamples && mixed) break;
+
+            if (checkpoint && iter % ckEvery == 0 && iter < LDA_ITER) {
+                flushDirty();   // nw_acc এর correction গুলো পুরো হোক
+                string snap = checkpointBytes(iter, burnEnd, llHist, fingerprint);
+                if (ckWriter.joinable()) ckWriter.join();
+                ckWriter = thread([path = ckPath, snap = move(snap)] {
+                    writeCheckpoint(path, snap);
+                });
+            }
         }
+        if (ckWriter.joinable()) ckWriter.join();
+        if (checkpoint) remove(ckPath.c_str());   // run শেষ — আর resume করার কিছু নেই
 
-<<<<<<< HEAD
-        if (acc_count > 0)
-            for (int v = 0; v < V; v++)
-                for (int k = 0; k < K; k++)
-                    nw_acc[v][k] /= acc_count;
-=======
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        if (iter < LDA_ITER)
+            progress() << "[Topic Model] Stopped early after " << iter << " / "
+                 << LDA_ITER << " iterations" << endl;
+        progress() << "[Topic Model] Throughput: " << fixed << setprecision(0)
+             << totalTokens * iter / max(secs, 1e-9) << " tokens/sec ("
+             << setprecision(2) << secs << "s)" << endl;
+
+        flushDirty();
+        trackDirty = false;
+        dirty.clear();
         if (acc_count > 0) {
-            for (int v = 0; v < V; v++)
-                for (int k = 0; k < K; k++)
-                    nw_acc[v][k] /= acc_count;
+            const lda_count_t* cnt = nw.data();
+            for (size_t c = 0; c < nw.size(); c++)
+                nw_acc[c] = (nw_acc[c] + (double)acc_count * cnt[c]) / acc_count;
             for (int k = 0; k < K; k++)
                 nwsum_acc[k] /= acc_count;   // average sum
         }
->>>>>>> 51c03b0
+        accRows = nw_acc.data();
+        mapped.reset();
+        tokIndex.clear();
+        buildLogPhi();
+
+        progress() << "[Topic Model] Training complete! Samples: " << acc_count << endl;
+        return true;
+    }
+
+    // chains টা independent Markov chain, প্রতিটা নিজের thread এ serial
+    // sampler চালায়; chain i এর seed (seed, i) থেকে, তাই একই seed আর chains
+    // এ result হুবহু এক। Topic label এ বাঁধা, তাই chain গুলোর topic মেলাতে
+    // হয় না — প্রতিটা chain এর averaged nw_acc/nwsum_acc এর গড়ই merged
+    // posterior। Chain গুলো এই object এর corpus পড়ে — chain প্রতি শুধু
+    // topics আর count matrix, corpus/vocab এর copy নেই।
+    void trainChains(int chains, uint32_t seed)
+    {
+        if (corpus.size() == 0 || acc_count > 0) {
+            cerr << "[ERROR] trainChains(): call after loadData(), before train()" << endl;
+            return;
+        }
+        if (!corpusFits("trainChains()")) return;
+        chains = max(1, chains);
+        cout << "[Topic Model] Training " << chains << " chains | seed " << seed << endl;
+
+        // নতুন object — numThreads 1, checkpoint বন্ধ, countsReady false
+        // (প্রতিটা chain নিজের seed এ initCounts()); settings গুলো এখান থেকে
+        vector<SupervisedLDA> run(chains);
+        for (int c = 0; c < chains; c++) {
+            SupervisedLDA& r = run[c];
+            seed_seq sq{seed, (uint32_t)c};
+            r.rng.seed(sq);
+            r.docsFrom = &corpus;
+            r.K = labelToId.size(); r.V = vocab.size();
+            r.alpha = alpha; r.beta = beta; r.eta = eta;
+            r.sampler = sampler; r.mhSteps = mhSteps;
+            r.earlyStop = earlyStop; r.convTol = convTol;
+            r.convWindow = convWindow; r.minSamples = minSamples;
+            r.verbose = c == 0;             // progress শুধু প্রথম chain এর
+        }
+        runThreads(chains, [&](int c) { run[c].train(); });
+
+        nw_acc.assign((size_t)V * K, 0.0);
+        nwsum_acc.assign(K, 0.0);
+        acc_count = 0;
+        for (int c = 0; c < chains; c++) {
+            const SupervisedLDA& r = run[c];
+            for (size_t i = 0; i < nw_acc.size(); i++) nw_acc[i] += r.nw_acc[i];
+            for (int k = 0; k < K; k++) nwsum_acc[k] += r.nwsum_acc[k];
+            acc_count += r.acc_count;
+            cout << "[Topic Model] Chain " << c << ": " << r.acc_count << " samples" << endl;
+        }
+        for (double& x : nw_acc)    x /= chains;
+        for (double& x : nwsum_acc) x /= chains;
+
+        // sampler state প্রথম chain এর টা রাখি
+        SupervisedLDA& first = run[0];
+        corpus.topics.swap(first.corpus.topics);
+        nw = move(first.nw); nd = move(first.nd);
+        nwsum = move(first.nwsum); ndsum = move(first.ndsum);
+        countsReady = true;
+
+        accRows = nw_acc.data();
+        mapped.reset();
+        buildLogPhi();
+        cout << "[Topic Model] Merged " << chains << " chains | Samples: " << acc_count << endl;
+    }
+
+    // নতুন "LABEL|text" line (input.txt এর format) model এ যোগ করে, পুরো
+    // corpus আবার train না করে। Vocab, nw আর nd জায়গাতেই বড় হয়; তারপর
+    // sweeps বার শুধু নতুন docs (আর প্রতি sweep এ rejuvenate টা random
+    // পুরনো doc) resample হয়। শেষ অর্ধেক sweep এ nw এর যে cell বদলেছে
+    // তাদের গড় বদল nw_acc এ যোগ হয়, log φ এর শুধু সেই row গুলো নতুন করে —
+    // খরচ নতুন token আর বদলানো cell এর অনুপাতে, V×K এর নয়।
+    // অজানা label এর line বাদ (K বদলাতে পুরো retrain লাগে)।
+    // train() / trainChains() এর পরে call; load() করা model এ sampler
+    // state নেই, তাই false।
+    bool addDocuments(const vector<string>& lines, int sweeps = 20, int rejuvenate = 0)
+    {
+        if (acc_count == 0 || resumed || nw.size() == 0 || shards) {
+            cerr << "[ERROR] addDocuments(): call after in-memory train() in this process" << endl;
+            return false;
+        }
+        auto t0 = chrono::steady_clock::now();
+        const int oldD = D;
+        const size_t oldN = corpus.tokens();
+        int skipped = 0;
+        long long maxLen = 0;
+        TokenBuffer tokens;
+        Vocabulary fresh;                  // নতুন word, id = V + fresh এর id — check এর পরে vocab এ
+        for (const string& line : lines) {
+            size_t pos = line.find('|');
+            auto it = pos == string::npos ? labelToId.end()
+                                          : labelToId.find(line.substr(0, pos));
+            if (it == labelToId.end()) { skipped++; continue; }
+            preprocessor.tokenize(string_view(line).substr(pos + 1), tokens);
+            if (tokens.empty()) { skipped++; continue; }
+            for (size_t i = 0; i < tokens.size(); i++) {
+                int w = vocab.find(tokens[i]);
+                corpus.words.push_back(w >= 0 ? w : V + fresh.intern(tokens[i]));
+            }
+            corpus.offsets.push_back(corpus.words.size());
+            corpus.labels.push_back(it->second);
+            maxLen = max<long long>(maxLen, tokens.size());
+        }
+        if (skipped > 0)
+            cerr << "[Warning] addDocuments(): skipped " << skipped
+                 << " lines with an unknown label or no words" << endl;
+        if (corpus.size() == oldD) return false;
+
+        // word এর frequency = nw row এর যোগফল + নতুন token — শুধু ছোঁয়া word এর
+        long long maxFreq = 0;
+        if (sizeof(lda_count_t) < sizeof(int)) {
+            unordered_map<int, long long> freq;
+            for (size_t i = oldN; i < corpus.tokens(); i++) freq[corpus.words[i]]++;
+            for (auto& [w, n] : freq) {
+                if (w < V) for (int k = 0; k < K; k++) n += nw(w, k);
+                maxFreq = max(maxFreq, n);
+            }
+        }
+        if (!countsFit("addDocuments()", maxFreq, maxLen)) {
+            corpus.words.resize(oldN);
+            corpus.offsets.resize(oldD + 1);
+            corpus.labels.resize(oldD);
+            return false;
+        }
+        for (int i = 0; i < fresh.size(); i++) vocab.intern(fresh.word(i));
+
+        D = corpus.size(); V = vocab.size();
+        nw.growRows(V);
+        nd.growRows(D);
+        ndsum.resize(D, 0);
+        nw_acc.resize((size_t)V * K, 0.0);
+
+        // update এ বদলানো প্রতিটা nw cell, update এর আগের মান সহ — hash set,
+        // তাই V×K bitmap লাগে না
+        dirty.resetSparse();
+        trackDirty = true;
+        const vector<int> nwsumBefore = nwsum;
+        corpus.topics.resize(corpus.tokens());
+        for (int d = oldD; d < D; ++d) {
+            const int label = corpus.labels[d];
+            for (size_t i = corpus.offsets[d]; i < corpus.offsets[d + 1]; ++i) {
+                int t = initialTopic(label);
+                size_t c = (size_t)corpus.words[i] * K + t;
+                dirty.mark(c, nw.data()[c]);
+                corpus.topics[i] = (lda_topic_t)t;
+                nw.data()[c]++;
+                nd(d, t)++; nwsum[t]++; ndsum[d]++;
+            }
+        }
+
+        span = spanOf(corpus);
+        sweeps = max(1, sweeps);
+        const int burn = sweeps / 2;
+        SamplerScratch sc;
+        vector<double> cellDelta;          // dirty.list এর index অনুযায়ী
+        vector<double> sumDelta(K, 0.0);
+        uniform_int_distribution<int> pickOld(0, max(0, oldD - 1));
+        for (int s = 0; s < sweeps; s++) {
+            sampleDocs(oldD, D, nw, nwsum, rng, sc);
+            for (int r = 0; r < rejuvenate && oldD > 0; r++) {
+                int d = pickOld(rng);
+                sampleDocs(d, d + 1, nw, nwsum, rng, sc);
+            }
+            if (s < burn) continue;
+            cellDelta.resize(dirty.list.size(), 0.0);
+            for (size_t j = 0; j < dirty.list.size(); j++)
+                cellDelta[j] += (int32_t)nw.data()[dirty.list[j].first] - dirty.list[j].second;
+            for (int k = 0; k < K; k++) sumDelta[k] += nwsum[k] - nwsumBefore[k];
+        }
+
+        const int samples = sweeps - burn;
+        for (size_t j = 0; j < dirty.list.size(); j++)
+            nw_acc[dirty.list[j].first] += cellDelta[j] / samples;
+        for (int k = 0; k < K; k++) nwsum_acc[k] += sumDelta[k] / samples;
+        const size_t changed = dirty.list.size();
+        vector<int> rows;                  // যে word গুলোর nw_acc বদলেছে (নতুন word সহ)
+        rows.reserve(changed);
+        for (auto& [c, before] : dirty.list) rows.push_back((int)(c / K));
+        trackDirty = false;
+        dirty.clear();
+
+        accRows = nw_acc.data();
+        mapped.reset();
+        if (phiDen.size() != (size_t)K) {
+            buildLogPhi();
+        } else {
+            // log φ শুধু বদলানো row এ; nwsum_acc আর V এর বদল phiShift এ
+            sort(rows.begin(), rows.end());
+            rows.erase(unique(rows.begin(), rows.end()), rows.end());
+            logPhiTable.resize((size_t)V * K);
+            logPhi = logPhiTable.data();
+            for (int w : rows) buildLogPhiRow(w);
+            phiShift.resize(K);
+            for (int k = 0; k < K; k++) phiShift[k] = phiDen[k] - log(nwsum_acc[k] + V * beta);
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << "[Topic Model] Added " << D - oldD << " docs | " << V << " vocab words | "
+             << changed << " cells updated | " << fixed << setprecision(1) << ms << "ms" << endl;
+        return true;
+    }
+
+    // ── Streaming trainer ─────────────────────────────────────────
+    // train() এর বিকল্প — stochastic variational inference (Hoffman et al.)।
+    // "LABEL|text" file টা batchSize doc এর batch এ পড়া হয়; memory তে থাকে
+    // শুধু vocab, V×K topic-word parameter λ আর চলতি batch — corpus এর
+    // topic assignment বা count matrix নেই, তাই memory corpus length এর
+    // উপর নির্ভর করে না। Local step Gibbs conditional এর মতোই supervised:
+    // φ[w][k] ∝ exp(E[log β_kw] + E[log θ_dk]), label topic এ ×eta।
+    // Global step: λ ← (1-ρ)λ + ρ(β + D/|B|·batch stats)।
+    // λ = β + scale·μ রাখা হয় — (1-ρ) decay শুধু scale এ, তাই batch এ
+    // শুধু batch এর word এর row এ হাত পড়ে। শেষে nw_acc = λ - β (expected
+    // counts), তাই predict()/save() আগের মতোই চলে। Sampler state থাকে না,
+    // তাই এর পরে addDocuments() চলে না। File না খুললে বা doc না থাকলে false।
+    bool trainStreaming(const string& filename, int batchSize = SVI_BATCH, int epochs = 1,
+                        double tau0 = SVI_TAU0, double kappa = SVI_KAPPA)
+    {
+        // Pass 1: শুধু label আর word আছে এমন doc এর সংখ্যা (D/|B| scaling
+        // এর জন্য) — O(K) memory
+        long long totalDocs = scanLabels(filename, true);
+        if (totalDocs == 0) return false;
+
+        K = labelToId.size(); V = 0; D = 0;
+        vocab.clear(); corpus.clear(); shards.reset();
+        nw.clear(); nd.clear(); nwsum.clear(); ndsum.clear();
+        tokIndex.clear(); mapped.reset();
+        countsReady = false; resumed = false;
+        string line;
+        batchSize = max(1, batchSize);
+        tau0      = max(tau0, 1.0);
+        kappa     = min(max(kappa, 0.5), 1.0);
+
+        vector<double>& mu = nw_acc;          // λ[w][k] = β + scale·mu[w][k]
+        mu.clear();
+        vector<double> muSum(K, 0.0);         // mu এর column sum
+        double scale = 1;
+
+        // চলতি batch: doc এর (batch-local word, count) CSR
+        vector<int>     docOff, docLabel, bw, bc;
+        vector<int32_t> batchWords;           // local → vocab id
+        vector<int>     localOf;              // vocab id → local, -1 = batch এ নেই
+        vector<int>     lastDoc, lastSlot;    // local word শেষ কোন doc এর bw এর কোথায়
+        TokenBuffer     tokens;
+        long long       unknown = 0;          // pass 1 এর পরে আসা নতুন label
+
+        auto readBatch = [&](istream& src) {
+            docOff.assign(1, 0); docLabel.clear(); bw.clear(); bc.clear();
+            for (int32_t id : batchWords) localOf[id] = -1;
+            batchWords.clear(); lastDoc.clear(); lastSlot.clear();
+            while ((int)docLabel.size() < batchSize && getline(src, line)) {
+                size_t pos = line.find('|');
+                if (pos == string::npos) continue;
+                preprocessor.tokenize(string_view(line).substr(pos + 1), tokens);
+                if (tokens.empty()) continue;
+                auto lab = labelToId.find(line.substr(0, pos));
+                if (lab == labelToId.end()) { unknown++; continue; }
+                const int d = docLabel.size();
+                for (size_t i = 0; i < tokens.size(); i++) {
+                    int id = vocab.intern(tokens[i]);
+                    if (id == (int)localOf.size()) {      // নতুন word: λ row = β
+                        localOf.push_back(-1);
+                        mu.resize(mu.size() + K, 0.0);
+                    }
+                    if (localOf[id] < 0) {
+                        localOf[id] = batchWords.size();
+                        batchWords.push_back(id);
+                        lastDoc.push_back(-1); lastSlot.push_back(0);
+                    }
+                    int u = localOf[id];
+                    if (lastDoc[u] == d) { bc[lastSlot[u]]++; continue; }
+                    lastDoc[u] = d; lastSlot[u] = bw.size();
+                    bw.push_back(u); bc.push_back(1);
+                }
+                docOff.push_back(bw.size());
+                docLabel.push_back(lab->second);
+            }
+            return !docLabel.empty();
+        };
+
+        const int T = numThreads;
+        vector<vector<double>> stats(T);
+        vector<double> expElogBeta;           // batch word × K
+        long long step = 0, docsSeen = 0;
+        double rho = 0;
+        auto t0 = chrono::steady_clock::now();
+        progress() << "[Topic Model] Streaming SVI — " << totalDocs << " docs | "
+             << K << " topics | batch " << batchSize << " | epochs " << epochs
+             << " | tau0 " << tau0 << " | kappa " << kappa << " | Threads: " << T << endl;
+
+        for (int ep = 0; ep < epochs; ep++) {
+            ifstream src(filename);
+            while (readBatch(src)) {
+                const int B = batchWords.size(), nb = docLabel.size();
+                V = vocab.size();
+                const double Vbeta = V * beta;
+
+                // batch এর word গুলোর exp(E[log β_kw]) = exp(ψ(λ_kw) - ψ(Σ_w λ_kw))
+                vector<double> elogDen(K);
+                for (int k = 0; k < K; k++) elogDen[k] = digamma(Vbeta + scale * muSum[k]);
+                expElogBeta.resize((size_t)B * K);
+                for (int u = 0; u < B; u++) {
+                    const double* m = mu.data() + (size_t)batchWords[u] * K;
+                    double* e = expElogBeta.data() + (size_t)u * K;
+                    for (int k = 0; k < K; k++) e[k] = exp(digamma(beta + scale * m[k]) - elogDen[k]);
+                }
+
+                // Local step: doc গুলো independent, thread প্রতি আলাদা stats
+                int Tb = min(T, nb);
+                runThreads(Tb, [&](int tid) {
+                    vector<double>& S = stats[tid];
+                    S.assign((size_t)B * K, 0.0);
+                    vector<double> gamma(K), next(K), expTheta(K);
+                    for (int d = nb * tid / Tb; d < nb * (tid + 1) / Tb; d++) {
+                        const int b = docOff[d], e = docOff[d + 1];
+                        int len = 0;
+                        for (int j = b; j < e; j++) len += bc[j];
+                        fill(gamma.begin(), gamma.end(), alpha + (double)len / K);
+                        for (int it = 0; it < SVI_LOCAL_ITER; it++) {
+                            // ψ(Σγ) সব k তে এক — normalize এ কাটা যায়
+                            for (int k = 0; k < K; k++) expTheta[k] = exp(digamma(gamma[k]));
+                            expTheta[docLabel[d]] *= eta;
+                            fill(next.begin(), next.end(), alpha);
+                            for (int j = b; j < e; j++) {
+                                const double* eb = expElogBeta.data() + (size_t)bw[j] * K;
+                                double norm = 0;
+                                for (int k = 0; k < K; k++) norm += eb[k] * expTheta[k];
+                                double w = bc[j] / norm;
+                                for (int k = 0; k < K; k++) next[k] += w * eb[k] * expTheta[k];
+                            }
+                            double change = 0;
+                            for (int k = 0; k < K; k++) change += fabs(next[k] - gamma[k]);
+                            gamma.swap(next);
+                            if (change / K < SVI_LOCAL_TOL) break;
+                        }
+                        for (int k = 0; k < K; k++) expTheta[k] = exp(digamma(gamma[k]));
+                        expTheta[docLabel[d]] *= eta;
+                        for (int j = b; j < e; j++) {
+                            const double* eb = expElogBeta.data() + (size_t)bw[j] * K;
+                            double norm = 0;
+                            for (int k = 0; k < K; k++) norm += eb[k] * expTheta[k];
+                            double w = bc[j] / norm;
+                            double* row = S.data() + (size_t)bw[j] * K;
+                            for (int k = 0; k < K; k++) row[k] += w * eb[k] * expTheta[k];
+                        }
+                    }
+                });
+
+                // Global step — decay scale এ, batch এর row গুলোতে শুধু যোগ
+                rho = pow(tau0 + (++step), -kappa);
+                scale *= 1 - rho;
+                const double w = rho * (double)totalDocs / nb / scale;
+                for (int u = 0; u < B; u++) {
+                    double* m = mu.data() + (size_t)batchWords[u] * K;
+                    for (int tid = 0; tid < Tb; tid++) {
+                        const double* row = stats[tid].data() + (size_t)u * K;
+                        for (int k = 0; k < K; k++) {
+                            m[k] += w * row[k];
+                            muSum[k] += w * row[k];
+                        }
+                    }
+                }
+                // scale underflow এর আগে একবার mu তে ঢেলে দিই
+                if (scale < 1e-100) {
+                    for (double& x : mu)    x *= scale;
+                    for (double& x : muSum) x *= scale;
+                    scale = 1;
+                }
+                docsSeen += nb;
+                if (step % 100 == 0) {
+                    auto elapsed = chrono::duration_cast<chrono::seconds>(
+                        chrono::steady_clock::now() - t0).count();
+                    progress() << "  Batch " << setw(5) << step << " | docs " << docsSeen
+                         << " | vocab " << V << " | rho " << fixed << setprecision(4) << rho
+                         << " | " << elapsed << "s" << endl;
+                }
+            }
+        }
+        if (unknown > 0)
+            cerr << "[Warning] trainStreaming(): skipped " << unknown
+                 << " lines with an unknown label" << endl;
+        if (docsSeen == 0) {
+            cerr << "[ERROR] no documents with words in " << filename << endl;
+            return false;
+        }
+
+        V = vocab.size();
+        for (double& x : mu) x *= scale;
+        nwsum_acc.assign(K, 0.0);
+        for (int k = 0; k < K; k++) nwsum_acc[k] = muSum[k] * scale;
+        acc_count = 1;                        // একটাই point estimate
+        accRows = nw_acc.data();
+        buildLogPhi();
 
-        cout << "[Topic Model] Training complete! Samples: " << acc_count << endl;
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        progress() << "[Topic Model] Streaming training complete! " << docsSeen << " docs | "
+             << V << " vocab words | " << step << " batches | " << fixed << setprecision(0)
+             << docsSeen / max(secs, 1e-9) << " docs/sec (" << setprecision(2) << secs << "s)" << endl;
+        return true;
     }
 
-    string predict(const string& input)
+    // একটা sentence score করে — কোনো shared state এ লেখে না
+    TopicPrediction predictOne(const string& input) const
     {
-<<<<<<< HEAD
-=======
-        if (acc_count == 0) return "NOT_TRAINED";
+        if (acc_count == 0) return {TOPIC_NOT_TRAINED, 0.0};
+        TokenBuffer tokens;
+        preprocessor.tokenize(input, tokens);
+        return scoreTokens(tokens);
+    }
 
->>>>>>> 51c03b0
-        vector<string> tokens = preprocessor.tokenize(input);
-        vector<int> testWords;
-        for (const string& tok : tokens)
-            if (wordToId.count(tok)) testWords.push_back(wordToId[tok]);
+    // আগেই analyze() করা document — আবার tokenize হয় না
+    TopicPrediction predictOne(const AnalyzedDocument& doc) const
+    {
+        if (acc_count == 0) return {TOPIC_NOT_TRAINED, 0.0};
+        return scoreTokens(doc.stems);
+    }
 
-        if (testWords.empty()) return "UNKNOWN";
+    // stemmed token গুলোর logPhi row যোগ করে সবচেয়ে ভালো topic
+    TopicPrediction scoreTokens(const TokenBuffer& tokens) const
+    {
+        TopicPrediction res;
+        vector<double> score(K, 0.0);
+        int matched = 0;
+        for (size_t i = 0; i < tokens.size(); i++) {
+            int id = vocab.find(tokens[i]);
+            if (id < 0) continue;
+            // table এর row যোগ — সব topic একসাথে, inner loop vectorize হয়।
+            // Vocab এর বাইরের word বাদ, তাই তাদের কোনো smoothing term নেই।
+            const float* row = logPhi + (size_t)id * K;
+            for (int k = 0; k < K; ++k) score[k] += row[k];
+            matched++;
+        }
+        if (matched == 0) return res;
+        if (!phiShift.empty())
+            for (int k = 0; k < K; ++k) score[k] += matched * phiShift[k];
 
         int bestK = 0; double maxScore = -1e18;
-        for (int k = 0; k < K; ++k) {
-            double score = 0;
-<<<<<<< HEAD
-            for (int wId : testWords)
-                score += log((nw[wId][k] + LDA_BETA) / (nwsum[k] + V * LDA_BETA));
-=======
-            for (int wId : testWords) {
-                double phi = (nw_acc[wId][k] + LDA_BETA) / (nwsum_acc[k] + V * LDA_BETA);
-                score += log(phi);
+        for (int k = 0; k < K; ++k)
+            if (score[k] > maxScore) { maxScore = score[k]; bestK = k; }
+        res.topic = bestK; res.score = maxScore;
+        return res;
+    }
+
+    // topic id → label; TOPIC_UNKNOWN / TOPIC_NOT_TRAINED এর জন্য পুরনো string
+    string topicLabel(int topic) const
+    {
+        if (topic == TOPIC_NOT_TRAINED) return "NOT_TRAINED";
+        if (topic < 0 || topic >= K)    return "UNKNOWN";
+        return idToLabel.at(topic);
+    }
+
+    string predict(const string& input) const
+    {
+        return topicLabel(predictOne(input).topic);
+    }
+
+    // অনেক sentence একসাথে — threads টা worker এ ভাগ হয় (0 = সব core)।
+    // Model এ কিছু লেখে না, তাই একই model থেকে একাধিক batch চালানো যায়।
+    vector<TopicPrediction> predictBatch(const vector<string>& inputs, int threads = 0) const
+    {
+        vector<TopicPrediction> out(inputs.size());
+        parallelFor(inputs.size(), resolveThreads(threads),
+                    [&](size_t i) { out[i] = predictOne(inputs[i]); });
+        return out;
+    }
+
+    vector<TopicPrediction> predictBatch(const vector<AnalyzedDocument>& docs, int threads = 0) const
+    {
+        vector<TopicPrediction> out(docs.size());
+        parallelFor(docs.size(), resolveThreads(threads),
+                    [&](size_t i) { out[i] = predictOne(docs[i]); });
+        return out;
+    }
+
+    // ── Model persistence ─────────────────────────────────────────
+    // Trained model (labels, vocab, averaged counts, hyperparameters)
+    // binary file এ লেখে — পরের run এ আর train() লাগে না
+    bool save(const string& filename) const
+    {
+        if (acc_count == 0) { cerr << "[ERROR] save(): model is not trained" << endl; return false; }
+
+        string tmp = filename + ".tmp";
+        ofstream out(tmp, ios::binary | ios::trunc);
+        if (!out.is_open()) { cerr << "[ERROR] cannot write " << tmp << endl; return false; }
+
+        auto putU32 = [&](uint32_t x) { out.write((const char*)&x, sizeof x); };
+        auto putF64 = [&](double x)   { out.write((const char*)&x, sizeof x); };
+        auto putStr = [&](string_view str) {
+            putU32((uint32_t)str.size()); out.write(str.data(), str.size());
+        };
+
+        out.write(MODEL_MAGIC, 4);
+        putU32(MODEL_VERSION);
+        putU32(K); putU32(V); putU32(acc_count); putU32(0);
+        putF64(alpha); putF64(beta); putF64(eta);
+        for (int k = 0; k < K; k++) putStr(idToLabel.at(k));
+        for (int v = 0; v < V; v++) putStr(vocab[v]);
+
+        // count block 8-byte boundary তে শুরু হয়
+        size_t pos = (size_t)out.tellp();
+        static const char zeros[8] = {0};
+        out.write(zeros, (8 - pos % 8) % 8);
+        out.write((const char*)nwsum_acc.data(), sizeof(double) * K);
+        out.write((const char*)accRows, sizeof(double) * (size_t)V * K);
+        if (phiShift.empty()) {
+            out.write((const char*)logPhi, sizeof(float) * (size_t)V * K);
+        } else {
+            // addDocuments() এর পরে: shift row গুলোতে বসিয়ে লিখি, file এ সবসময় exact table
+            vector<float> row(K);
+            for (int w = 0; w < V; w++) {
+                for (int k = 0; k < K; k++) row[k] = (float)(logPhi[(size_t)w * K + k] + phiShift[k]);
+                out.write((const char*)row.data(), sizeof(float) * K);
             }
->>>>>>> 51c03b0
-            if (score > maxScore) { maxScore = score; bestK = k; }
         }
-        return idToLabel[bestK];
+        out.close();
+        if (!out) { cerr << "[ERROR] failed writing " << tmp << endl; remove(tmp.c_str()); return false; }
+
+        // tmp → final rename, যাতে আধা-লেখা model কেউ load না করে
+        remove(filename.c_str());
+        if (rename(tmp.c_str(), filename.c_str()) != 0) {
+            cerr << "[ERROR] cannot rename " << tmp << " to " << filename << endl;
+            return false;
+        }
+        cout << "[Topic Model] Saved model to " << filename << endl;
+        return true;
+    }
+
+    // useMmap = true হলে averaged counts copy না করে file থেকে সরাসরি পড়া হয়;
+    // একাধিক process একই page-cached model share করতে পারে
+    bool load(const string& filename, bool useMmap = true)
+    {
+        auto file = make_shared<MappedFile>();
+        if (!file->open(filename)) return false;
+
+        const char* p   = file->data();
+        const char* end = p + file->size();
+        bool ok = true;
+        auto need   = [&](size_t n) { if (p > end || (size_t)(end - p) < n) ok = false; return ok; };
+        auto getU32 = [&]() { uint32_t x = 0; if (need(4)) { memcpy(&x, p, 4); p += 4; } return x; };
+        auto getF64 = [&]() { double x = 0; if (need(8)) { memcpy(&x, p, 8); p += 8; } return x; };
+        auto getStr = [&]() {
+            uint32_t n = getU32(); string str;
+            if (ok && need(n)) { str.assign(p, n); p += n; }
+            return str;
+        };
+
+        if (!need(4) || memcmp(p, MODEL_MAGIC, 4) != 0) {
+            cerr << "[ERROR] " << filename << " is not a topic model file" << endl;
+            return false;
+        }
+        p += 4;
+        uint32_t version = getU32();
+        if (version < 1 || version > MODEL_VERSION) {
+            cerr << "[ERROR] " << filename << ": unsupported model version " << version << endl;
+            return false;
+        }
+        uint32_t k = getU32(), v = getU32(), samples = getU32();
+        getU32();
+        double a = getF64(), b = getF64(), e = getF64();
+
+        // header এর k, v বিশ্বাস করার আগে file এর আকারের সাথে মেলাই — label/word
+        // প্রতি অন্তত ৪ byte এর length, আর V×K double এর count block। ভাঙা
+        // header এ বিশাল allocation এর বদলে false।
+        size_t left = ok ? (size_t)(end - p) : 0;
+        if (!ok || (uint64_t)k + v > left / 4 || (uint64_t)k * v > left / sizeof(double)) {
+            cerr << "[ERROR] " << filename << " is truncated" << endl;
+            return false;
+        }
+
+        vector<string> labels(k);
+        for (auto& s : labels) s = getStr();
+        // word গুলো mapped file থেকে সরাসরি vocab এ intern হয়
+        Vocabulary words;
+        words.reserve(v);
+        for (uint32_t i = 0; i < v && ok; i++) {
+            uint32_t n = getU32();
+            if (!need(n)) break;
+            if (words.intern(string_view(p, n)) != (int)i) {
+                cerr << "[ERROR] " << filename << ": duplicate vocab word" << endl;
+                return false;
+            }
+            p += n;
+        }
+
+        size_t pos = p - file->data();
+        if (need((8 - pos % 8) % 8)) p += (8 - pos % 8) % 8;
+        size_t tableBytes = version >= 2 ? sizeof(float) * (size_t)v * k : 0;
+        if (!ok || !need(sizeof(double) * (k + (size_t)v * k) + tableBytes)) {
+            cerr << "[ERROR] " << filename << " is truncated" << endl;
+            return false;
+        }
+
+        K = k; V = v; D = 0; acc_count = samples;
+        alpha = a; beta = b; eta = e;
+        labelToId.clear(); idToLabel.clear();
+        for (int i = 0; i < K; i++) { labelToId[labels[i]] = i; idToLabel[i] = labels[i]; }
+        vocab = move(words);
+        corpus.clear(); nw.clear(); nd.clear(); nwsum.clear(); ndsum.clear();
+        // আগের loadData()/train()/loadShards() এর sampler state আর নেই
+        countsReady = false; resumed = false;
+        shards.reset(); shardTokenCount = 0;
+        tokIndex.clear();
+
+        nwsum_acc.assign((const double*)p, (const double*)p + K);
+        p += sizeof(double) * K;
+        const float* table = (const float*)(p + sizeof(double) * (size_t)V * K);
+        if (useMmap) {
+            nw_acc.clear();
+            accRows = (const double*)p;
+            mapped  = file;
+        } else {
+            nw_acc.assign((const double*)p, (const double*)p + (size_t)V * K);
+            accRows = nw_acc.data();
+            mapped.reset();
+        }
+        phiDen.clear(); phiShift.clear();
+        if (version < 2) {
+            buildLogPhi();
+        } else if (useMmap) {
+            logPhiTable.clear();
+            logPhi = table;
+        } else {
+            logPhiTable.assign(table, table + (size_t)V * K);
+            logPhi = logPhiTable.data();
+        }
+        cout << "[Topic Model] Loaded model " << filename << " | "
+             << K << " topics | " << V << " vocab words" << endl;
+        return true;
     }
-<<<<<<< HEAD
-};
-=======
 
 };
 
 inline map<string, vector<string>> clusterByTopic(
-    SupervisedLDA& model,
+    const SupervisedLDA& model,
     const vector<string>& sentences)
 {
     map<string, vector<string>> clusters;
-    for (const string& s : sentences)
-        clusters[model.predict(s)].push_back(s);
+    vector<TopicPrediction> preds = model.predictBatch(sentences);
+    for (size_t i = 0; i < sentences.size(); i++)
+        clusters[model.topicLabel(preds[i].topic)].push_back(sentences[i]);
     return clusters;
 }
->>>>>>> 51c03b0
@@ -0,0 +1,100 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "perfect_hash.h"
+using namespace std;
+
+// ═══════════════════════════════════════════════════════════════════
+//  VOCABULARY
+//  word ↔ id, id গুলো insert ক্রমে 0,1,2...। সব word একটা arena
+//  string এ পরপর থাকে (আলাদা heap block নেই); lookup open-addressing
+//  table এ linear probe — একটা hash, সাধারণত একটা slot, একটা compare।
+//  string_view দিয়েই lookup/insert, কোনো temporary string লাগে না।
+// ═══════════════════════════════════════════════════════════════════
+class Vocabulary
+{
+    string           arena;    // সব word পরপর
+    vector<uint32_t> ends;     // word i = arena[ends[i-1], ends[i])
+    vector<uint32_t> hashes;   // word i এর hash — grow এর সময় আবার hash করতে হয় না
+    vector<int32_t>  slots;    // id + 1; 0 = খালি। size power of 2, load ≤ 0.5
+
+    static uint32_t hashOf(string_view w) { return phMix(phHash(w), 0); }
+
+    // w এর slot, নয়তো যে খালি slot এ বসবে
+    size_t probe(string_view w, uint32_t h) const
+    {
+        const size_t mask = slots.size() - 1;
+        for (size_t s = h & mask;; s = (s + 1) & mask) {
+            int32_t e = slots[s];
+            if (e == 0) return s;
+            if (hashes[e - 1] == h && word(e - 1) == w) return s;
+        }
+    }
+
+    void rehash(size_t n)
+    {
+        slots.assign(n, 0);
+        const size_t mask = n - 1;
+        for (size_t id = 0; id < ends.size(); id++) {
+            size_t s = hashes[id] & mask;
+            while (slots[s] != 0) s = (s + 1) & mask;
+            slots[s] = (int32_t)id + 1;
+        }
+    }
+
+public:
+    Vocabulary() { slots.assign(16, 0); }
+
+    int  size()  const { return (int)ends.size(); }
+    bool empty() const { return ends.empty(); }
+
+    string_view word(int id) const
+    {
+        size_t b = id ? ends[id - 1] : 0;
+        return string_view(arena.data() + b, ends[id] - b);
+    }
+    string_view operator[](int id) const { return word(id); }
+
+    // না থাকলে -1
+    int find(string_view w) const
+    {
+        int32_t e = slots[probe(w, hashOf(w))];
+        return e - 1;
+    }
+
+    // থাকলে সেই id, নইলে নতুন id দিয়ে যোগ করে — একটাই probe
+    int intern(string_view w)
+    {
+        uint32_t h = hashOf(w);
+        size_t   s = probe(w, h);
+        if (slots[s] != 0) return slots[s] - 1;
+
+        int id = size();
+        arena.append(w.data(), w.size());
+        ends.push_back((uint32_t)arena.size());
+        hashes.push_back(h);
+        slots[s] = id + 1;
+        if (2 * ends.size() > slots.size()) rehash(slots.size() * 2);
+        return id;
+    }
+
+    void reserve(size_t words, size_t chars = 0)
+    {
+        ends.reserve(words); hashes.reserve(words);
+        if (chars) arena.reserve(chars);
+        size_t n = slots.size();
+        while (n < 2 * words) n *= 2;
+        if (n != slots.size()) rehash(n);
+    }
+
+    void clear() { *this = Vocabulary(); }
+
+    // arena + id arrays + table, byte এ
+    size_t memoryBytes() const
+    {
+        return arena.capacity() + (ends.capacity() + hashes.capacity()) * sizeof(uint32_t)
+             + slots.capacity() * sizeof(int32_t);
+    }
+};